@@ -9,19 +9,90 @@ Each implementation provides both a Node type and a native sum_list function.
 A cross-language test uses a single Python sum_list on all node types.
 """
 
+import argparse
+import array
+import collections
+import contextlib
+import cProfile
+import dis
+import functools
+import gc
+import importlib
+import importlib.machinery
+import importlib.util
+import json
+import os
 import platform
+import random
+import re
+import shutil
+import signal
+import statistics
 import subprocess
 import sys
+import sysconfig
+import tempfile
+import threading
 import time
+import traceback
+import tracemalloc
+import types
 
 from python_node import PyNode, py_sum_list
 
 # Import C and Rust extensions
-from c_node import CNode, c_sum_list
+from c_node import CNode, c_load_stream, c_sum_list
 from rust_node import RustNode, rust_sum_list
 
 N = 1000       # list length
 M = 100_000    # iterations
+TARGET_TIME = None   # --target-time: seconds per bench() row, else M calls
+SAMPLE_SHARE = 0.1   # bench()'s sample pass: this share of the timed calls,
+SAMPLE_MIN = 1_000   # but at least this many (capped at the timed calls)
+ANOMALIES = ()       # environment_anomalies() as printed in the header
+
+
+def optional_import(module, *names):
+    """Import names from an optional extension, or None if it is not built.
+
+    With no names, returns the module itself.
+    """
+    try:
+        mod = importlib.import_module(module)
+    except ImportError:
+        return None
+    if not names:
+        return mod
+    return tuple(getattr(mod, name) for name in names)
+
+
+# Optional extensions — their rows are skipped when not built.
+C_NOGC = optional_import("c_node_nogc", "CNodeNoGC", "c_sum_list_nogc",
+                         "c_load_stream_nogc")
+C_NOGC_ARENA = optional_import("c_node_nogc", "c_arena_open_nogc",
+                               "c_arena_close_nogc", "c_arena_info_nogc")
+
+C_TYPED = optional_import("c_node_typed")
+C_PACKED = optional_import("c_node_packed")
+C_ALLOC = optional_import("c_alloc")
+C_LOCALITY = optional_import("c_bench", "c_locality_report")
+C_CYCLES = optional_import("c_bench", "c_cycle_counter", "CYCLE_COUNTER")
+C_EVICT = optional_import("c_bench", "c_evict", "c_flush")
+C_LATENCY = optional_import("c_bench", "c_latency")
+C_NOOP = optional_import("c_bench", "c_noop")
+C_NOOP_FASTCALL = optional_import("c_bench", "c_noop_fastcall")
+RUST_NOOP = optional_import("rust_node", "rust_noop")
+
+# (label, version-specific build, Limited API / abi3 build)
+ABI3_PAIRS = [
+    ("C (GC)", (CNode, c_sum_list),
+     optional_import("c_node_abi3", "CNodeAbi3", "c_sum_list_abi3")),
+    ("C (no GC)", C_NOGC and C_NOGC[:2],
+     optional_import("c_node_nogc_abi3", "CNodeNoGCAbi3",
+                     "c_sum_list_nogc_abi3")),
+    ("Rust", (RustNode, rust_sum_list),
+     optional_import("rust_node_abi3", "RustNode", "rust_sum_list")),
+]
 
 
 def build_list(NodeClass, n):
@@ -33,6 +104,26 @@ def build_list(NodeClass, n):
     return head
 
 
+def build_list_from(NodeClass, values):
+    """Build a linked list holding values in order; None if values is empty."""
+    head = None
+    for v in reversed(values):
+        head = NodeClass(value=v, next=head)
+    return head
+
+
+def build_shuffled_list(NodeClass, n, seed=0):
+    """Build values 0..n-1 allocated in address order but linked in a
+    random order, so each step of a traversal lands somewhere else."""
+    assert n > 0, f"List length must be positive, got {n}"
+    nodes = [NodeClass(value=i, next=None) for i in range(n)]
+    order = list(range(n))
+    random.Random(seed).shuffle(order)
+    for a, b in zip(order, order[1:]):
+        nodes[a].next = nodes[b]
+    return nodes[order[0]]
+
+
 def python_sum_list(head):
     """Python traversal — same code, any node type.
 
@@ -50,26 +141,1814 @@ def python_sum_list(head):
     return total
 
 
-def bench(label, fn, head, iterations):
-    """Run a benchmark with warmup and timing."""
+def python_noop(head):
+    """Empty Python function: calibrates python_sum_list's call cost.
+    Returning None is a fair match: the loop's last += made the result
+    int, as part of the per-node work."""
+    return None
+
+
+def noop_for(fn):
+    """(label, empty function with fn's calling convention) or None: the
+    empty METH_O c_noop for the c_node* sum functions (all METH_O),
+    c_noop_fastcall for builtin sum (METH_FASTCALL | METH_KEYWORDS),
+    rust_noop for PyO3 ones and python_noop for Python ones. None for
+    anything else, whose call overhead none of them matches."""
+    module = getattr(fn, "__module__", None) or ""
+    if module.startswith("rust_node"):
+        return ("Rust #[pyfunction]", RUST_NOOP[0]) if RUST_NOOP else None
+    if isinstance(fn, types.FunctionType):
+        return ("Python function", python_noop)
+    if fn is sum:
+        return (("C METH_FASTCALL", C_NOOP_FASTCALL[0])
+                if C_NOOP_FASTCALL else None)
+    if (isinstance(fn, types.BuiltinFunctionType)
+            and module.startswith("c_node")):
+        return ("C METH_O", C_NOOP[0]) if C_NOOP else None
+    return None
+
+
+@functools.cache
+def call_overhead_ns(noop, calls=200_000):
+    """ns per noop(None) in measure()'s loop: the for-loop step and call
+    dispatch every timed call pays besides the traversal."""
+    return min(measure(noop, None, calls, warmup=calls // 10)
+               for _ in range(3))
+
+
+def overhead_summary(fn, ns, n):
+    """Calibrated call overhead of fn and ns/node net of it, or ""."""
+    noop = noop_for(fn)
+    if noop is None:
+        return ""
+    overhead = call_overhead_ns(noop[1])
+    return (f"overhead {overhead:.0f} ns/call, "
+            f"net {max(0.0, ns - overhead) / n:.3f} ns/node")
+
+
+def python_sum_iter(values):
+    """Python loop over a flat container: the floor for python_sum_list."""
+    total = 0
+    for v in values:
+        total += v
+    return total
+
+
+def build_cons(n):
+    """Values 0..n-1 as nested (value, rest) tuples, ending in None."""
+    cell = None
+    for i in range(n - 1, -1, -1):
+        cell = (i, cell)
+    return cell
+
+
+def python_sum_cons(cell):
+    """Python loop over a tuple cons chain: a linked list without a class."""
+    total = 0
+    while cell is not None:
+        value, cell = cell
+        total += value
+    return total
+
+
+def container_baselines(n):
+    """(label, structure) of 0..n-1 in each built-in container."""
+    values = list(range(n))
+    return [
+        ("list", values),
+        ("tuple", tuple(values)),
+        ("array('q')", array.array("q", values)),
+        ("deque", collections.deque(values)),
+        ("cons tuples", build_cons(n)),
+        ("range", range(n)),
+    ]
+
+
+def read_cycles():
+    """Reference cycle count (c_bench.c_cycle_counter), or None."""
+    return C_CYCLES[0]() if C_CYCLES else None
+
+
+def measure_cycles(fn, head, iterations, warmup=1000):
+    """Warm up, then return (mean ns, mean reference cycles) per
+    fn(head) call; cycles is None without a cycle counter."""
     assert iterations > 0, f"Iterations must be positive, got {iterations}"
     assert callable(fn), f"fn must be callable, got {type(fn)}"
 
     # Warmup — let CPython specialise LOAD_ATTR etc.
-    for _ in range(1000):
+    for _ in range(warmup):
         fn(head)
 
     # Timed run
+    c0 = read_cycles()
     t0 = time.perf_counter_ns()
     for _ in range(iterations):
         fn(head)
     elapsed_ns = time.perf_counter_ns() - t0
+    c1 = read_cycles()
+
+    cycles = (c1 - c0) / iterations if c0 is not None else None
+    return elapsed_ns / iterations, cycles
+
+
+def warm_until_steady(fn, head, window=5, cv=0.02, max_seconds=2.0,
+                      batch_ns=1_000_000):
+    """Call fn(head) in ~1 ms batches until the last window batch means
+    agree within cv (coefficient of variation), or max_seconds pass.
+
+    Returns (ns per call over the last window, warmup calls, steady).
+    """
+    t0 = time.perf_counter_ns()
+    fn(head)
+    first = max(1, time.perf_counter_ns() - t0)
+    batch = max(1, batch_ns // first)
+    calls = 1
+    means = []
+    deadline = t0 + int(max_seconds * 1e9)
+    while True:
+        t0 = time.perf_counter_ns()
+        for _ in range(batch):
+            fn(head)
+        t1 = time.perf_counter_ns()
+        calls += batch
+        means.append((t1 - t0) / batch)
+        recent = means[-window:]
+        if len(recent) == window:
+            mean = statistics.fmean(recent)
+            if statistics.stdev(recent) <= cv * mean:
+                return mean, calls, True
+        if t1 >= deadline:
+            return statistics.fmean(recent), calls, False
+
+
+def measure_adaptive(fn, head, target_seconds):
+    """Warm up to steady state, then time enough calls to fill
+    target_seconds. Returns (mean ns, mean reference cycles, iterations,
+    warmup calls, steady)."""
+    estimate, warmup, steady = warm_until_steady(fn, head)
+    iterations = max(3, int(target_seconds * 1e9 / estimate))
+    ns, cycles = measure_cycles(fn, head, iterations, warmup=0)
+    return ns, cycles, iterations, warmup, steady
+
+
+def measure(fn, head, iterations, warmup=1000):
+    """Warm up, then return mean ns per fn(head) call."""
+    return measure_cycles(fn, head, iterations, warmup)[0]
+
+
+def chain_length(head):
+    """Nodes in head's chain, following .next; len() of a flat list."""
+    if head is not None and not hasattr(head, "next"):
+        return len(head)
+    n = 0
+    while head is not None:
+        n += 1
+        head = head.next
+    return n
+
+
+@functools.cache
+def cycle_counter_hz():
+    """Rate of the reference cycle counter, calibrated against
+    perf_counter_ns over 50 ms; None without a counter."""
+    c0, t0 = read_cycles(), time.perf_counter_ns()
+    if c0 is None:
+        return None
+    time.sleep(0.05)
+    c1, t1 = read_cycles(), time.perf_counter_ns()
+    return (c1 - c0) * 1e9 / (t1 - t0)
+
+
+def current_cpu():
+    """CPU this process last ran on (/proc/self/stat), or None."""
+    try:
+        with open("/proc/self/stat") as f:
+            fields = f.read().rsplit(")", 1)[1].split()
+    except OSError:
+        return None
+    return int(fields[36])  # field 39, "processor"
+
+
+def cpu_freq_ghz(cpu):
+    """Effective frequency of cpu in GHz: cpufreq's scaling_cur_freq
+    (APERF/MPERF-based on recent kernels), else /proc/cpuinfo's
+    "cpu MHz"; None if neither is available."""
+    if cpu is None:
+        return None
+    try:
+        with open(f"/sys/devices/system/cpu/cpu{cpu}/cpufreq/"
+                  "scaling_cur_freq") as f:
+            return int(f.read()) / 1e6
+    except (OSError, ValueError):
+        pass
+    try:
+        with open("/proc/cpuinfo") as f:
+            blocks = f.read().split("\n\n")
+    except OSError:
+        return None
+    for block in blocks:
+        info = dict(line.split(":", 1) for line in block.splitlines()
+                    if ":" in line)
+        info = {k.strip(): v.strip() for k, v in info.items()}
+        if info.get("processor") == str(cpu) and "cpu MHz" in info:
+            return float(info["cpu MHz"]) / 1e3
+    return None
+
+
+def read_sysfs(path, default="unknown"):
+    try:
+        with open(path) as f:
+            return f.read().strip()
+    except OSError:
+        return default
+
+
+def cpu_governor():
+    return read_sysfs("/sys/devices/system/cpu/cpu0/cpufreq/"
+                      "scaling_governor")
+
+
+def cpu_boost():
+    """Turbo/boost state: 'on', 'off' or 'unknown'."""
+    no_turbo = read_sysfs("/sys/devices/system/cpu/intel_pstate/no_turbo")
+    if no_turbo in ("0", "1"):
+        return "off" if no_turbo == "1" else "on"
+    boost = read_sysfs("/sys/devices/system/cpu/cpufreq/boost")
+    if boost in ("0", "1"):
+        return "on" if boost == "1" else "off"
+    return "unknown"
+
+
+def parse_cpu_list(text):
+    """Kernel CPU list, e.g. '0-3,8', as a set of ints."""
+    cpus = set()
+    for part in text.split(","):
+        if "-" in part:
+            lo, hi = part.split("-")
+            cpus.update(range(int(lo), int(hi) + 1))
+        elif part.strip():
+            cpus.add(int(part))
+    return cpus
+
+
+def format_cpu_list(cpus):
+    """Set of ints as a kernel CPU list, e.g. {0, 1, 2, 3, 8} -> '0-3,8'."""
+    ranges = []
+    for cpu in sorted(cpus):
+        if ranges and ranges[-1][1] == cpu - 1:
+            ranges[-1][1] = cpu
+        else:
+            ranges.append([cpu, cpu])
+    return ",".join(str(lo) if lo == hi else f"{lo}-{hi}" for lo, hi in ranges)
+
+
+def cpu_numa_node(cpu):
+    """NUMA node of cpu from its sysfs nodeN link, or None."""
+    try:
+        entries = os.listdir(f"/sys/devices/system/cpu/cpu{cpu}")
+    except OSError:
+        return None
+    nodes = [int(e[4:]) for e in entries if re.fullmatch(r"node\d+", e)]
+    return nodes[0] if nodes else None
+
+
+def cpu_busy(cpus, interval=0.1):
+    """{cpu: fraction of interval not idle} from two /proc/stat samples."""
+    def sample():
+        times = {}
+        try:
+            with open("/proc/stat") as f:
+                for line in f:
+                    m = re.match(r"cpu(\d+) (.*)", line)
+                    if m and int(m[1]) in cpus:
+                        fields = [int(x) for x in m[2].split()]
+                        # idle + iowait
+                        times[int(m[1])] = (sum(fields), fields[3] + fields[4])
+        except OSError:
+            pass
+        return times
+
+    before = sample()
+    time.sleep(interval)
+    after = sample()
+    busy = {}
+    for cpu, (total, idle) in after.items():
+        if cpu in before:
+            d_total = total - before[cpu][0]
+            d_idle = idle - before[cpu][1]
+            busy[cpu] = 1 - d_idle / d_total if d_total else 0.0
+    return busy
+
+
+def environment_anomalies(pinned):
+    """Conditions that make timings unstable, as human-readable strings.
+
+    pinned says whether --cpus was given; otherwise the scheduler may
+    move the benchmark between cores, and on multi-socket hosts between
+    NUMA nodes, mid-run.
+    """
+    anomalies = []
+    governor = cpu_governor()
+    if governor != "performance":
+        anomalies.append(f"CPU governor is '{governor}', not 'performance'")
+    if cpu_boost() == "unknown":
+        anomalies.append("turbo/boost state is unknown")
+    aslr = read_sysfs("/proc/sys/kernel/randomize_va_space")
+    if aslr != "0":
+        anomalies.append(f"ASLR is on (kernel.randomize_va_space={aslr})")
+
+    allowed = os.sched_getaffinity(0)
+    nodes = sorted({cpu_numa_node(c) for c in allowed} - {None})
+    if len(nodes) > 1:
+        anomalies.append(f"CPUs span NUMA nodes {nodes}: the process and "
+                         f"its memory may end up on different sockets")
+    if not pinned and len(allowed) > 1:
+        anomalies.append(f"not pinned (--cpus): may migrate across "
+                         f"{len(allowed)} CPUs")
+
+    siblings = set()
+    for cpu in allowed:
+        siblings |= parse_cpu_list(read_sysfs(
+            f"/sys/devices/system/cpu/cpu{cpu}/topology/thread_siblings_list",
+            str(cpu)))
+    for cpu, busy in sorted(cpu_busy(siblings - allowed).items()):
+        if busy > 0.1:
+            anomalies.append(f"SMT sibling cpu{cpu} of a benchmark CPU is "
+                             f"{busy:.0%} busy")
+    return anomalies
+
+
+def print_row_anomalies(results):
+    """Anomaly lines under a table row for conditions its child processes
+    saw (each result's "anomalies") that the header didn't already list."""
+    seen = dict.fromkeys(a for r in results for a in r["anomalies"])
+    for anomaly in seen:
+        if anomaly not in ANOMALIES:
+            print(f"  Anomaly:  {anomaly}")
+
+
+def locality_summary(head):
+    """One-line c_locality_report of head's chain, or "" if not built.
+
+    same-line/same-page are the fractions of next hops staying within a
+    cache line/page, fwd the fraction of hops to a higher address and
+    step the most common address delta in bytes.
+    """
+    if C_LOCALITY is None or head is None or not hasattr(head, "next"):
+        return ""
+    (report,) = C_LOCALITY
+    r = report(head)
+    hops = max(1, r["nodes"] - 1)
+    step = r["common_deltas"][0][0] if r["common_deltas"] else 0
+    return (f"same-line {r['same_line']:4.2f}  "
+            f"same-page {r['same_page']:4.2f}  "
+            f"fwd {r['forward'] / hops:4.2f}  "
+            f"pages {r['distinct_pages']:5d}  step {step:+d}")
+
+
+def latency_summary(fn, head, calls):
+    """Per-call latency percentiles of fn(head) from c_latency, or "" if
+    c_bench is not built. Tails show GC runs, page faults and preemption
+    that a mean hides."""
+    if C_LATENCY is None:
+        return ""
+    (latency,) = C_LATENCY
+    r = latency(fn, head, calls)
+    return "  ".join(f"{key} {r[key]:,}" for key in
+                     ("p50", "p90", "p99", "p99.9", "max")) + " ns"
+
+
+def cycles_summary(ns, ref_cycles, n, cycles=None):
+    """ns/node, reference cycles/node and core cycles/node for one
+    measurement of an n-node chain. Core cycles are the per-call count
+    from perf when given, otherwise estimated as ns/node times the
+    effective frequency and labelled as such."""
+    n = max(n, 1)
+    text = f"{ns / n:6.2f} ns/node"
+    if ref_cycles is not None:
+        text += f"  {ref_cycles / n:6.2f} ref-cyc/node"
+    if cycles is not None:
+        text += f"  {cycles / n:6.2f} cyc/node"
+        return text
+    ghz = cpu_freq_ghz(current_cpu())
+    if ghz:
+        text += f"  {ns / n * ghz:6.2f} est. cyc/node @ {ghz:4.2f} GHz"
+    return text
+
+
+def sample_calls(iterations):
+    """Calls in bench()'s sample pass after iterations timed ones:
+    SAMPLE_SHARE of them, at least SAMPLE_MIN (enough for a p99.9), at
+    most all."""
+    return min(iterations, max(SAMPLE_MIN, int(iterations * SAMPLE_SHARE)))
+
+
+def bench(label, fn, head, iterations, n=None):
+    """Run a benchmark with warmup and timing. n is the number of values
+    traversed, by default chain_length(head).
+
+    After the timed calls, one bounded sample pass (sample_calls) fills
+    the latency histogram while perf, if available, counts its cycles.
+
+    With TARGET_TIME set, iterations is ignored: warmup runs until the
+    timings are steady, then the timed calls and the sample pass share
+    TARGET_TIME seconds.
+    """
+    n = n or chain_length(head)
+    adaptive = None
+    if TARGET_TIME:
+        ns_per, ref_cycles, iterations, warmup, steady = measure_adaptive(
+            fn, head, TARGET_TIME / (1 + SAMPLE_SHARE))
+        adaptive = (f"warmup {warmup:,} calls"
+                    f"{'' if steady else ' (not steady)'}, "
+                    f"{iterations:,} timed")
+    else:
+        ns_per, ref_cycles = measure_cycles(fn, head, iterations)
+    sample = sample_calls(iterations)
+    with perf_stat(["cycles"]) as counts:
+        latency = latency_summary(fn, head, sample)
+        if counts is not None and not latency:  # no c_latency to call fn
+            for _ in range(sample):
+                fn(head)
+    cycles = counts and counts["cycles"]
+    cycles = cycles / sample if cycles else None
+    print(f"{label:40s}  {ns_per:8.0f} ns/traversal  "
+          f"{cycles_summary(ns_per, ref_cycles, n, cycles)}  "
+          f"{locality_summary(head)}".rstrip())
+    overhead = overhead_summary(fn, ns_per, n)
+    details = "  ".join(x for x in (overhead, latency, adaptive) if x)
+    if details:
+        print(f"{'':40s}  {details}")
+    return ns_per
+
+
+@contextlib.contextmanager
+def perf_stat(events):
+    """Count hardware events in this process for the with block.
+
+    Attaches `perf stat` for the duration of the block. Yields None when
+    perf is missing or cannot attach (perf_event_paranoid), else a dict
+    filled in on exit: {event: count}, with None for events perf could
+    not count.
+    """
+    if shutil.which("perf") is None:
+        yield None
+        return
+    proc = subprocess.Popen(
+        ["perf", "stat", "-x", ",", "-e", ",".join(events),
+         "-p", str(os.getpid())],
+        stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    time.sleep(0.2)  # give perf time to attach before the block starts
+    if proc.poll() is not None:
+        yield None
+        return
+
+    counts = dict.fromkeys(events)
+    try:
+        yield counts
+    finally:
+        proc.send_signal(signal.SIGINT)
+        _, err = proc.communicate(timeout=10)
+    for line in err.splitlines():
+        fields = line.split(",")
+        if len(fields) < 3:
+            continue
+        for event in events:
+            if event in fields[2]:  # may be decorated, e.g. cpu_core/...
+                try:
+                    counts[event] = int(fields[0])
+                except ValueError:  # <not supported> / <not counted>
+                    pass
+
+
+def perf_counters(events, fn, head, iterations):
+    """perf_stat's counts over iterations calls of fn(head), or None."""
+    with perf_stat(events) as counts:
+        for _ in range(iterations):
+            fn(head)
+    return counts
+
+
+def node_footprint(node):
+    """Bytes one node occupies: sys.getsizeof (which includes PyGC_Head
+    for GC-tracked objects) rounded up to the 16-byte allocator quantum."""
+    return (sys.getsizeof(node) + 15) // 16 * 16
+
+
+def bench_build(label, NodeClass, n, iterations):
+    """Time build_list(NodeClass, n); deallocation is excluded."""
+    assert iterations > 0, f"Iterations must be positive, got {iterations}"
+
+    for _ in range(10):
+        build_list(NodeClass, n)
+
+    elapsed_ns = 0
+    for _ in range(iterations):
+        t0 = time.perf_counter_ns()
+        head = build_list(NodeClass, n)
+        elapsed_ns += time.perf_counter_ns() - t0
+        del head
 
     ns_per = elapsed_ns / iterations
-    print(f"{label:40s}  {ns_per:8.0f} ns/traversal")
+    print(f"{label:40s}  {ns_per:8.0f} ns/build")
     return ns_per
 
 
+def bench_abi3(n, iterations):
+    """Construction and traversal: version-specific vs abi3 builds."""
+    expected = n * (n - 1) // 2
+    build_iterations = max(1, iterations // 100)
+
+    for label, native, abi3 in ABI3_PAIRS:
+        if native is None or abi3 is None:
+            missing = "abi3" if abi3 is None else "version-specific"
+            print(f"{label}: {missing} module not built, skipped")
+            continue
+        results = {}
+        for variant, (NodeClass, sum_fn) in (("native", native),
+                                             ("abi3", abi3)):
+            head = build_list(NodeClass, n)
+            assert sum_fn(head) == expected, \
+                f"{label} {variant} wrong: {sum_fn(head)} != {expected}"
+            build_ns = bench_build(f"{label} {variant}, build", NodeClass,
+                                   n, build_iterations)
+            sum_ns = bench(f"{label} {variant}, traverse", sum_fn, head,
+                           iterations)
+            results[variant] = (build_ns, sum_ns)
+        (nb, ns), (ab, as_) = results["native"], results["abi3"]
+        print(f"  abi3 / native: build {ab / nb:5.2f}x "
+              f"({(ab - nb) / n:+.1f} ns/node), "
+              f"traverse {as_ / ns:5.2f}x ({(as_ - ns) / n:+.2f} ns/node)")
+
+
+def bench_ingest(records, chunk, iterations=5):
+    """Streaming ingest of int64 records vs Python ints + build_list.
+
+    Writes a temporary file of little-endian int64 records 0..records-1,
+    then loads it repeatedly. The native loaders read chunk bytes at a
+    time; the Python path reads the whole file and builds Python ints
+    before constructing the list.
+    """
+    values = array.array("q", range(records))
+    if sys.byteorder != "little":
+        values.byteswap()
+    expected = records * (records - 1) // 2
+    size_mb = records * values.itemsize / 1e6
+
+    def py_ingest(path):
+        with open(path, "rb") as f:
+            data = array.array("q")
+            data.frombytes(f.read())
+        if sys.byteorder != "little":
+            data.byteswap()
+        return build_list_from(CNode, data.tolist())
+
+    def fd_ingest(load):
+        def run(path):
+            fd = os.open(path, os.O_RDONLY)
+            try:
+                return load(fd, chunk=chunk)
+            finally:
+                os.close(fd)
+        return run
+
+    def file_ingest(load):
+        def run(path):
+            with open(path, "rb", buffering=0) as f:
+                return load(f, chunk=chunk)
+        return run
+
+    cases = [
+        ("Python ints + build_list (CNode)", py_ingest, c_sum_list),
+        ("c_load_stream, fd read(2)", fd_ingest(c_load_stream), c_sum_list),
+        ("c_load_stream, readinto()", file_ingest(c_load_stream),
+         c_sum_list),
+    ]
+    if C_NOGC is not None:
+        _, sum_nogc, load_nogc = C_NOGC
+        cases.append(("c_load_stream_nogc, fd read(2)",
+                      fd_ingest(load_nogc), sum_nogc))
+
+    with tempfile.NamedTemporaryFile(suffix=".i64", delete=False) as f:
+        f.write(values.tobytes())
+        path = f.name
+    del values
+    try:
+        print(f"Streaming ingest: {records:,} records ({size_mb:.1f} MB), "
+              f"chunk {chunk:,} bytes, {iterations} loads each")
+        print(f"{'Loader':40s}  {'ns/record':>9s}  {'MB/s':>8s}")
+        print("-" * 62)
+        for label, load, sum_fn in cases:
+            head = load(path)
+            assert sum_fn(head) == expected, \
+                f"{label} wrong: {sum_fn(head)} != {expected}"
+            del head
+            elapsed_ns = 0
+            for _ in range(iterations):
+                t0 = time.perf_counter_ns()
+                head = load(path)
+                elapsed_ns += time.perf_counter_ns() - t0
+                del head
+            ns = elapsed_ns / iterations
+            print(f"{label:40s}  {ns / records:9.1f}  "
+                  f"{size_mb / (ns / 1e9):8.0f}")
+    finally:
+        os.unlink(path)
+
+
+def bench_dtypes(n, iterations):
+    """Traversal cost and footprint per value dtype, node vs flat layout."""
+    if C_TYPED is None:
+        print("c_node_typed not built, skipped")
+        return
+    t = C_TYPED
+    expected = n * (n - 1) // 2
+
+    # (label, structure, sum function, bytes/node)
+    cases = []
+    if C_NOGC is not None:
+        head = build_list(C_NOGC[0], n)
+        cases.append(("long, CNodeNoGC", head, C_NOGC[1],
+                      node_footprint(head)))
+    dtypes = [("int32", t.CNodeInt32, t.CFlatListInt32, range(n), [""]),
+              ("float64", t.CNodeFloat64, t.CFlatListFloat64,
+               [float(i) for i in range(n)], ["", "_kahan", "_pairwise"])]
+    if hasattr(t, "CNodeInt128"):
+        dtypes.append(("int128", t.CNodeInt128, t.CFlatListInt128,
+                       range(n), [""]))
+    for name, NodeClass, FlatClass, values, kernels in dtypes:
+        head = build_list_from(NodeClass, values)
+        flat = FlatClass(values)
+        for kernel in kernels:
+            variant = f" ({kernel[1:]})" if kernel else ""
+            cases.append((f"{name}{variant}, CNode{name.title()}", head,
+                          getattr(t, f"c_sum_list_{name}{kernel}"),
+                          node_footprint(head)))
+            cases.append((f"{name}{variant}, CFlatList{name.title()}", flat,
+                          getattr(t, f"c_sum_flat_{name}{kernel}"),
+                          flat.nbytes / len(flat)))
+
+    print(f"Typed values: {n:,} nodes, {iterations:,} iterations")
+    print(f"{'Benchmark':40s}  {'ns/traversal':>14s}")
+    print("-" * 56)
+    rows = []
+    for label, structure, sum_fn, nbytes in cases:
+        assert sum_fn(structure) == expected, \
+            f"{label} wrong: {sum_fn(structure)} != {expected}"
+        rows.append((label, bench(label, sum_fn, structure, iterations),
+                     nbytes))
+
+    print(f"\n{'Structure':40s}  {'ns/node':>8s}  {'bytes/node':>10s}")
+    print("-" * 62)
+    for label, ns, nbytes in rows:
+        print(f"{label:40s}  {ns / n:8.2f}  {nbytes:10.1f}")
+
+
+def timestamp_values(n, delta_lo=500, delta_hi=1500, seed=0):
+    """Monotonic int64 'timestamps' with jittered gaps, like event logs.
+
+    Values are offsets from the start of the log so that their sum stays
+    within int64; compression depends only on the gaps.
+    """
+    rng = random.Random(seed)
+    v = 0
+    values = []
+    for _ in range(n):
+        values.append(v)
+        v += rng.randint(delta_lo, delta_hi)
+    return values
+
+
+def bench_packed(sizes, node_budget, delta_lo, delta_hi):
+    """Size sweep: flat int64 list vs delta/bit-packed blocks.
+
+    Each size runs node_budget / size traversals (at least 3), so every
+    cell touches about the same number of nodes.
+    """
+    if C_TYPED is None or C_PACKED is None:
+        print("c_node_typed / c_node_packed not built, skipped")
+        return
+    t, p = C_TYPED, C_PACKED
+
+    print(f"Packed int64 storage: deltas {delta_lo}..{delta_hi}, "
+          f"~{node_budget:,} nodes traversed per cell")
+    print(f"{'nodes':>11s}  {'structure':28s}  {'ns/node':>8s}  "
+          f"{'bytes/node':>10s}  {'MiB':>9s}")
+    print("-" * 74)
+    for n in sizes:
+        values = timestamp_values(n, delta_lo, delta_hi)
+        expected = sum(values)
+        flat = t.CFlatListInt64(values)
+        packed = p.CPackedListInt64(values)
+        del values
+        iterations = max(3, node_budget // n)
+        warmup = max(1, iterations // 10)
+        for label, structure, sum_fn in (
+                ("CFlatListInt64", flat, t.c_sum_flat_int64),
+                ("CPackedListInt64 (scalar)", packed,
+                 p.c_sum_packed_int64_scalar),
+                ("CPackedListInt64 (SIMD)", packed, p.c_sum_packed_int64)):
+            assert sum_fn(structure) == expected, \
+                f"{label} wrong: {sum_fn(structure)} != {expected}"
+            ns = measure(sum_fn, structure, iterations, warmup)
+            print(f"{n:11,d}  {label:28s}  {ns / n:8.3f}  "
+                  f"{structure.nbytes / n:10.2f}  "
+                  f"{structure.nbytes / 2**20:9.1f}")
+        del flat, packed
+
+
+def thp_mode():
+    """The kernel's transparent huge page policy, e.g. 'madvise'."""
+    try:
+        with open("/sys/kernel/mm/transparent_hugepage/enabled") as f:
+            text = f.read()
+    except OSError:
+        return "unknown"
+    return text[text.find("[") + 1:text.find("]")] if "[" in text else text
+
+
+def bench_hugepages(sizes, node_budget):
+    """CNodeNoGC traversal from pymalloc vs 4 KiB and huge-page arenas.
+
+    Reports ns/node and dTLB load misses/node for sequential lists and
+    for lists linked in random order across their arena.
+    """
+    if C_NOGC is None:
+        print("c_node_nogc not built, skipped")
+        return
+    NodeNoGC, sum_nogc = C_NOGC[:2]
+    arena_open, arena_close, _ = C_NOGC_ARENA
+    events = ["dTLB-load-misses"]
+
+    print(f"Huge-page arenas: transparent huge pages '{thp_mode()}', "
+          f"~{node_budget:,} nodes traversed per cell")
+    print(f"{'nodes':>11s}  {'layout':10s}  {'allocation':16s}  "
+          f"{'ns/node':>8s}  {'dTLB miss/node':>14s}")
+    print("-" * 68)
+    for n in sizes:
+        expected = n * (n - 1) // 2
+        iterations = max(3, node_budget // n)
+        for layout, build in (("sequential", build_list),
+                              ("shuffled", build_shuffled_list)):
+            for allocation in ("pymalloc", "arena 4k", "arena huge"):
+                backing = None
+                if allocation != "pymalloc":
+                    # Exactly n nodes; c_arena_open_nogc rounds the mapping
+                    # up to whole 2 MiB pages itself.
+                    backing = arena_open(n * node_footprint(NodeNoGC(0)),
+                                         hugepages=allocation == "arena huge")
+                    allocation = f"arena {backing}"
+                head = None
+                done = False
+                try:
+                    head = build(NodeNoGC, n)
+                    assert sum_nogc(head) == expected, \
+                        f"{allocation} wrong: {sum_nogc(head)} != {expected}"
+                    ns = measure(sum_nogc, head, iterations,
+                                 max(1, iterations // 10))
+                    counts = perf_counters(events, sum_nogc, head,
+                                           iterations)
+                    done = True
+                except BaseException as exc:
+                    # Callee frames on the traceback still reach the nodes;
+                    # drop their locals so the arena can close below.
+                    traceback.clear_frames(exc.__traceback__)
+                    raise
+                finally:
+                    head = None  # the arena only closes once its nodes die
+                    if backing is not None:
+                        try:
+                            arena_close()
+                        except (RuntimeError, OSError):
+                            # After a failed cell, report that failure and
+                            # not the close.
+                            if done:
+                                raise
+                misses = counts and counts["dTLB-load-misses"]
+                per_node = (f"{misses / (n * iterations):14.3f}"
+                            if misses is not None else f"{'n/a':>14s}")
+                print(f"{n:11,d}  {layout:10s}  {allocation:16s}  "
+                      f"{ns / n:8.3f}  {per_node}")
+
+
+def bench_allocators(n, iterations):
+    """Build and traverse every node type under each c_alloc allocator.
+
+    The node extensions are unchanged: c_alloc swaps the interpreter's
+    object allocator, so only node placement (and the allocator's own
+    cost during construction) differs between rows.
+    """
+    if C_ALLOC is None:
+        print("c_alloc not built, skipped")
+        return
+    if os.environ.get("PYTHONMALLOC"):
+        print("PYTHONMALLOC is set; c_alloc needs the default raw "
+              "allocator, skipped")
+        return
+
+    node_types = [("Python", PyNode, py_sum_list),
+                  ("C (GC)", CNode, c_sum_list),
+                  ("C (no GC)", *(C_NOGC[:2] if C_NOGC else (None, None))),
+                  ("Rust", RustNode, rust_sum_list)]
+    expected = n * (n - 1) // 2
+    build_iterations = max(1, iterations // 100)
+    loop_iterations = max(1, iterations // 10)
+
+    print(f"Allocators: {n} nodes, {iterations:,} native / "
+          f"{loop_iterations:,} Python-loop traversals")
+    print(f"{'allocator':10s}  {'nodes':10s}  {'build ns/node':>13s}  "
+          f"{'native ns/node':>14s}  {'Py loop ns/node':>15s}")
+    print("-" * 70)
+    for allocator in ("pymalloc", "malloc", "pool", "arena"):
+        for label, NodeClass, sum_fn in node_types:
+            if NodeClass is None:
+                continue
+            C_ALLOC.use(allocator)
+            try:
+                head = build_list(NodeClass, n)
+                assert sum_fn(head) == expected, \
+                    f"{allocator} {label} wrong: {sum_fn(head)} != {expected}"
+                build_ns = 0
+                for _ in range(build_iterations):
+                    t0 = time.perf_counter_ns()
+                    other = build_list(NodeClass, n)
+                    build_ns += time.perf_counter_ns() - t0
+                    del other
+                native_ns = measure(sum_fn, head, iterations)
+                loop_ns = measure(python_sum_list, head, loop_iterations)
+                locality = locality_summary(head)
+                del head
+            finally:
+                C_ALLOC.use("pymalloc")
+            print(f"{allocator:10s}  {label:10s}  "
+                  f"{build_ns / build_iterations / n:13.1f}  "
+                  f"{native_ns / n:14.2f}  {loop_ns / n:15.2f}  "
+                  f"{locality}".rstrip())
+    stats = C_ALLOC.stats()
+    print(f"c_alloc region: {stats['region_used'] / 2**20:,.0f} MiB used, "
+          f"{stats['fallbacks']:,} malloc fallbacks")
+
+
+def objdump_listing(path, symbol):
+    """(offset in symbol, instruction) for each instruction of symbol in
+    a shared object, normalised so builds with different layouts compare
+    equal: absolute branch targets, RIP-relative displacements and
+    objdump comments are dropped. None if objdump or the symbol is
+    missing."""
+    if shutil.which("objdump") is None:
+        return None
+    result = subprocess.run(
+        ["objdump", "-d", "--no-show-raw-insn", f"--disassemble={symbol}",
+         path],
+        capture_output=True, text=True,
+    )
+    listing = []
+    start = None
+    for line in result.stdout.splitlines():
+        address, _, insn = line.partition(":\t")
+        if not insn or not address.strip().isalnum():
+            continue
+        address = int(address, 16)
+        start = address if start is None else start
+        insn = insn.split("#")[0]
+        insn = re.sub(r"\b[0-9a-f]+ <", "<", insn)
+        insn = re.sub(r"-?0x[0-9a-f]+\(%rip\)", "X(%rip)", insn)
+        listing.append((address - start, " ".join(insn.split())))
+    return listing or None
+
+
+def disassemble(path, symbol):
+    """Normalised instructions of symbol (see objdump_listing), or None."""
+    listing = objdump_listing(path, symbol)
+    return listing and [insn for _, insn in listing]
+
+
+def hot_loop(path, symbol):
+    """Normalised instructions of symbol's first loop (the traversal, in
+    the sum functions): from the target of the first backward branch to
+    that branch. Two builds with the same loop pay the same per node,
+    whatever differs around it (a USDT probe's nop, a register kept live
+    for its arguments). None if there is no loop or no objdump."""
+    listing = objdump_listing(path, symbol)
+    for end, insn in listing or ():
+        target = re.match(r"j\w+ <[^>+]*\+0x([0-9a-f]+)>", insn)
+        if target and int(target.group(1), 16) <= end:
+            start = int(target.group(1), 16)
+            return [re.sub(r"<[^>]*>", "<loop>", insn) if offset == end
+                    else insn
+                    for offset, insn in listing if start <= offset <= end]
+    return None
+
+
+def usdt_probes(path):
+    """provider:name of each USDT probe (stapsdt note) in a shared object;
+    None if readelf is missing."""
+    if shutil.which("readelf") is None:
+        return None
+    result = subprocess.run(["readelf", "-n", path],
+                            capture_output=True, text=True)
+    providers = re.findall(r"Provider: (\S+)\s+Name: (\S+)", result.stdout)
+    return [f"{provider}:{name}" for provider, name in providers]
+
+
+def load_extension_from(name, directory):
+    """Load extension module name from a build in directory without
+    touching sys.modules, so two builds can be compared side by side.
+    None if directory holds no such extension."""
+    for suffix in importlib.machinery.EXTENSION_SUFFIXES:
+        path = os.path.join(directory, name + suffix)
+        if os.path.exists(path):
+            loader = importlib.machinery.ExtensionFileLoader(name, path)
+            spec = importlib.util.spec_from_file_location(name, path,
+                                                          loader=loader)
+            module = importlib.util.module_from_spec(spec)
+            loader.exec_module(module)
+            return module
+    return None
+
+
+# (module, sum function, stats function, node type)
+COUNTER_MODULES = [
+    ("c_node", "c_sum_list", "c_stats", "CNode"),
+    ("c_node_nogc", "c_sum_list_nogc", "c_stats_nogc", "CNodeNoGC"),
+]
+
+
+def bench_counters(n, iterations, baseline=None):
+    """Cost of the instrumentation compiled into the C sum functions.
+
+    Reports whether the loaded c_node/c_node_nogc builds have the
+    C_NODE_STATS counters compiled in, how many USDT probes they carry,
+    their traversal time and the instruction count of the sum function.
+    With baseline (a directory holding the same extensions
+    built from the previous revision, or without counters) each sum
+    function is also timed and diffed instruction for instruction
+    against it. USDT probes add a nop each and keep their arguments
+    live, so a build only matches a baseline with the same probes; the
+    traversal loop is compared on its own as well, since it is where the
+    per-node cost is.
+    """
+    expected = n * (n - 1) // 2
+    print(f"Traversal counters: {n} nodes, {iterations:,} iterations"
+          + (f", baseline {baseline}" if baseline else ""))
+    print(f"{'build':28s}  {'counters':8s}  {'usdt':>4s}  {'ns/node':>8s}  "
+          f"{'instructions':>12s}  vs baseline")
+    print("-" * 84)
+    for module_name, sum_name, stats_name, node_name in COUNTER_MODULES:
+        module = optional_import(module_name)
+        if module is None:
+            print(f"{module_name} not built, skipped")
+            continue
+        builds = [(module_name, module)]
+        base = baseline and load_extension_from(module_name, baseline)
+        if baseline and base is None:
+            print(f"{module_name}: no build in {baseline}")
+        elif base is not None:
+            builds.append((f"{module_name} (baseline)", base))
+
+        base_insns = base and disassemble(base.__file__, sum_name)
+        base_loop = base and hot_loop(base.__file__, sum_name)
+        base_probes = base and usdt_probes(base.__file__)
+        for label, mod in builds:
+            stats = getattr(mod, stats_name, lambda: None)
+            sum_fn = getattr(mod, sum_name)
+            head = build_list(getattr(mod, node_name), n)
+            assert sum_fn(head) == expected, \
+                f"{label} wrong: {sum_fn(head)} != {expected}"
+            ns = measure(sum_fn, head, iterations)
+            insns = disassemble(mod.__file__, sum_name)
+            if mod is base or base_insns is None or insns is None:
+                verdict = "-"
+            elif insns == base_insns:
+                verdict = "identical"
+            else:
+                verdict = f"differs ({len(base_insns)} instructions)"
+                loop = hot_loop(mod.__file__, sum_name)
+                if loop is not None and base_loop is not None:
+                    verdict += (", loop identical" if loop == base_loop
+                                else ", loop differs")
+            probes = usdt_probes(mod.__file__)
+            if (mod is not base and base_insns and insns != base_insns
+                    and probes != base_probes):
+                verdict += ", USDT probes differ"
+            count = f"{len(insns):12d}" if insns else f"{'n/a':>12s}"
+            enabled = "on" if stats() is not None else "off"
+            usdt = (f"{len(probes):4d}" if probes is not None
+                    else f"{'n/a':>4s}")
+            print(f"{label:28s}  {enabled:8s}  {usdt}  {ns / n:8.3f}  "
+                  f"{count}  {verdict}")
+
+        stats = getattr(module, stats_name)()
+        if stats is not None:
+            # A few more shapes, and one rejected head, for the histogram
+            sum_fn = getattr(module, sum_name)
+            for length in (1, 10, 100):
+                sum_fn(build_list(getattr(module, node_name), length))
+            sum_fn(None)
+            try:
+                sum_fn(object())
+            except TypeError:
+                pass
+            stats = getattr(module, stats_name)()
+            lengths = ", ".join(f"<={k}: {v:,}" if k else f"empty: {v:,}"
+                                for k, v in stats["lengths"].items())
+            print(f"  {stats_name}(): {stats['traversals']:,} traversals, "
+                  f"{stats['nodes']:,} nodes, "
+                  f"{stats['type_failures']} type failures, "
+                  f"{stats['threads']} thread(s)")
+            print(f"  lengths: {lengths}")
+
+
+# Native traversals (loop and nodes in one language): key -> (label, node
+# type, sum function). Keys name the implementation to child processes.
+NATIVE_IMPLS = {
+    "python": ("Python", PyNode, py_sum_list),
+    "c": ("C (GC)", CNode, c_sum_list),
+    "c_nogc": ("C (no GC)", *(C_NOGC[:2] if C_NOGC else (None, None))),
+    "rust": ("Rust", RustNode, rust_sum_list),
+}
+CACHEGRIND_TRAVERSALS = 10
+
+
+def cachegrind_child(impl, n, traversals):
+    """Body of one simulated run: build, warm up, traverse.
+
+    Run twice per cell, with traversals=0 and traversals=K; everything
+    but the timed traversals is identical, so the difference in event
+    counts is K warm traversals.
+    """
+    _, NodeClass, sum_fn = NATIVE_IMPLS[impl]
+    head = build_list(NodeClass, n)
+    gc.disable()
+    sum_fn(head)
+    for _ in range(traversals):
+        sum_fn(head)
+
+
+def cachegrind_events(impl, n, traversals, d1, ll):
+    """Run cachegrind_child under cachegrind; {event: count} totals."""
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, "cachegrind.out")
+        cmd = ["valgrind", "--tool=cachegrind", "--cache-sim=yes",
+               f"--D1={d1}", f"--cachegrind-out-file={out}"]
+        if ll:
+            cmd.append(f"--LL={ll}")
+        cmd += [sys.executable, os.path.abspath(__file__),
+                "--cachegrind-child", impl, "--nodes", str(n),
+                "--traversals", str(traversals)]
+        env = dict(os.environ, PYTHONHASHSEED="0")
+        subprocess.run(cmd, check=True, env=env, stdout=subprocess.DEVNULL,
+                       stderr=subprocess.DEVNULL)
+        events = summary = None
+        with open(out) as f:
+            for line in f:
+                if line.startswith("events:"):
+                    events = line.split()[1:]
+                elif line.startswith("summary:"):
+                    summary = [int(x) for x in line.split()[1:]]
+    return dict(zip(events, summary))
+
+
+def bench_cachegrind(n, geometries, ll):
+    """Simulated cache misses per node, one row per implementation and
+    D1 geometry ("size,assoc,line"), independent of the host's caches."""
+    if shutil.which("valgrind") is None:
+        print("valgrind not found, skipped")
+        return
+    k = CACHEGRIND_TRAVERSALS
+    print(f"Cachegrind: {n} nodes, {k} warm traversals per cell, "
+          f"LL {ll or 'host default'}")
+    print(f"{'D1 (size,assoc,line)':22s}  {'implementation':14s}  "
+          f"{'Ir/node':>8s}  {'D1 miss/node':>12s}  {'LL miss/node':>12s}")
+    print("-" * 76)
+    for d1 in geometries:
+        for impl, (label, NodeClass, _) in NATIVE_IMPLS.items():
+            if NodeClass is None:
+                continue
+            base = cachegrind_events(impl, n, 0, d1, ll)
+            run = cachegrind_events(impl, n, k, d1, ll)
+
+            def per_node(*names):
+                total = sum(run.get(e, 0) - base.get(e, 0) for e in names)
+                return total / (k * n)
+
+            print(f"{d1:22s}  {label:14s}  {per_node('Ir'):8.1f}  "
+                  f"{per_node('D1mr', 'D1mw'):12.3f}  "
+                  f"{per_node('DLmr', 'DLmw'):12.3f}")
+
+
+def parse_cache_size(text):
+    """sysfs cache size, e.g. '48K' or '32M', in bytes."""
+    units = {"K": 1 << 10, "M": 1 << 20, "G": 1 << 30}
+    text = text.strip()
+    if text and text[-1] in units:
+        return int(text[:-1]) * units[text[-1]]
+    return int(text)
+
+
+def cache_levels(cpu=0):
+    """[(name, bytes)] of cpu's data and unified caches, from sysfs,
+    innermost first, e.g. [("L1d", 49152), ("L2", 2097152), ...]."""
+    base = f"/sys/devices/system/cpu/cpu{cpu}/cache"
+    levels = []
+    try:
+        entries = sorted(os.listdir(base))
+    except OSError:
+        return levels
+    for entry in entries:
+        if not entry.startswith("index"):
+            continue
+        path = os.path.join(base, entry)
+        kind = read_sysfs(os.path.join(path, "type"))
+        if kind not in ("Data", "Unified"):
+            continue
+        level = int(read_sysfs(os.path.join(path, "level"), "0"))
+        size = parse_cache_size(read_sysfs(os.path.join(path, "size"), "0"))
+        name = f"L{level}d" if kind == "Data" else f"L{level}"
+        levels.append((level, name, size))
+    return [(name, size) for _, name, size in sorted(levels)]
+
+
+def list_bytes_per_node(NodeClass, n=1000):
+    """Heap bytes per node of build_list(NodeClass, n) per tracemalloc:
+    the node object plus anything it owns (a PyNode's value int and
+    attribute storage), i.e. the traversal's working set per node."""
+    tracemalloc.start()
+    try:
+        before = tracemalloc.get_traced_memory()[0]
+        head = build_list(NodeClass, n)
+        after = tracemalloc.get_traced_memory()[0]
+    finally:
+        tracemalloc.stop()
+    del head
+    return (after - before) / n
+
+
+CALIBRATION_FILLS = (0.5, 0.9, 1.1, 2.0)
+
+
+def bench_calibrate(node_budget, levels=None):
+    """Native traversals sized from the host's cache hierarchy.
+
+    For each cache level and implementation, list lengths are chosen so
+    the list fills 50%, 90%, 110% and 200% of the cache at the
+    implementation's measured bytes/node.
+    """
+    caches = cache_levels()
+    if not caches:
+        print("cache sizes unavailable (no /sys/devices/system/cpu/cpu0/"
+              "cache), skipped")
+        return
+    if levels:
+        caches = [(name, size) for name, size in caches
+                  if int(name[1]) in levels]
+
+    impls = [(label, NodeClass, sum_fn)
+             for label, NodeClass, sum_fn in NATIVE_IMPLS.values()
+             if NodeClass is not None]
+    per_node = {label: list_bytes_per_node(NodeClass)
+                for label, NodeClass, _ in impls}
+
+    print("Cache calibration: "
+          + ", ".join(f"{name} {size >> 10:,} KiB" for name, size in caches)
+          + f"; ~{node_budget:,} nodes traversed per cell")
+    print("Bytes/node (tracemalloc): "
+          + ", ".join(f"{label} {b:.0f}" for label, b in per_node.items()))
+    print(f"{'cache':6s}  {'implementation':14s}  {'fill':>5s}  "
+          f"{'nodes':>11s}  {'ns/node':>8s}  {'ref-cyc/node':>12s}")
+    print("-" * 66)
+    for name, size in caches:
+        for label, NodeClass, sum_fn in impls:
+            for fill in CALIBRATION_FILLS:
+                n = max(1, int(fill * size / per_node[label]))
+                head = build_list(NodeClass, n)
+                expected = n * (n - 1) // 2
+                assert sum_fn(head) == expected, \
+                    f"{label} wrong: {sum_fn(head)} != {expected}"
+                iterations = max(3, node_budget // n)
+                ns, cycles = measure_cycles(sum_fn, head, iterations,
+                                            max(1, iterations // 10))
+                del head
+                ref = (f"{cycles / n:12.2f}" if cycles is not None
+                       else f"{'n/a':>12s}")
+                print(f"{name:6s}  {label:14s}  {fill:5.0%}  {n:11,d}  "
+                      f"{ns / n:8.3f}  {ref}")
+
+
+COLD_TRAVERSALS = 20
+EVICT_DEFAULT = 256 << 20   # sweep size when the cache sizes are unknown
+
+
+def timer_overhead_ns(samples=1000):
+    """Smallest gap between two back-to-back perf_counter_ns() calls."""
+    best = None
+    for _ in range(samples):
+        t0 = time.perf_counter_ns()
+        t1 = time.perf_counter_ns()
+        if best is None or t1 - t0 < best:
+            best = t1 - t0
+    return best
+
+
+def measure_cold(fn, head, traversals, evict):
+    """Per-call ns of fn(head), each call preceded by evict() and timed
+    on its own, less the timer's own overhead. Sorted ascending."""
+    overhead = timer_overhead_ns()
+    times = []
+    for _ in range(traversals):
+        evict()
+        t0 = time.perf_counter_ns()
+        fn(head)
+        t1 = time.perf_counter_ns()
+        times.append(max(0, t1 - t0 - overhead))
+    return sorted(times)
+
+
+def bench_cold(n, iterations, method):
+    """Native traversals started cold, against the same lists warm.
+
+    sweep: c_evict stores through a buffer twice the size of the largest
+    cache before every traversal, so the nodes, the interpreter's own
+    data and the page-table entries are all evicted.
+    flush: c_flush evicts just the node objects from every level.
+    """
+    if not C_EVICT:
+        print("c_bench not built, skipped")
+        return
+    c_evict, c_flush = C_EVICT
+    caches = cache_levels()
+    sweep_bytes = 2 * max((size for _, size in caches), default=0) \
+        or EVICT_DEFAULT
+
+    print(f"Cold traversals: {n:,} nodes, {COLD_TRAVERSALS} per row; "
+          + (f"evicted by a {sweep_bytes >> 20:,} MiB sweep" if
+             method == "sweep" else "node lines flushed"))
+    print(f"{'implementation':14s}  {'order':10s}  {'warm ns/node':>12s}  "
+          f"{'cold p50':>9s}  {'cold max':>9s}  {'cold/warm':>9s}")
+    print("-" * 72)
+    for label, NodeClass, sum_fn in NATIVE_IMPLS.values():
+        if NodeClass is None:
+            continue
+        for order, build in (("sequential", build_list),
+                             ("shuffled", build_shuffled_list)):
+            try:
+                head = build(NodeClass, n)
+            except AttributeError:   # frozen RustNode: next is read-only
+                print(f"{label:14s}  {order:10s}  next is immutable, skipped")
+                continue
+            expected = n * (n - 1) // 2
+            assert sum_fn(head) == expected, \
+                f"{label} wrong: {sum_fn(head)} != {expected}"
+            warm = measure(sum_fn, head, iterations) / n
+            if method == "sweep":
+                evict = functools.partial(c_evict, sweep_bytes)
+            else:
+                evict = functools.partial(c_flush, head)
+            cold = measure_cold(sum_fn, head, COLD_TRAVERSALS, evict)
+            p50 = cold[len(cold) // 2] / n
+            print(f"{label:14s}  {order:10s}  {warm:12.3f}  {p50:9.3f}  "
+                  f"{cold[-1] / n:9.3f}  {p50 / warm:8.1f}x")
+            del head
+
+
+def format_bytes(n):
+    """Bytes as KiB, MiB or GiB, whichever keeps 1-4 integer digits."""
+    for unit, shift in (("GiB", 30), ("MiB", 20)):
+        if n >= 1 << shift:
+            return f"{n / (1 << shift):,.1f} {unit}"
+    return f"{n / 1024:,.1f} KiB"
+
+
+def time_lists(sum_fn, heads, passes):
+    """Mean ns per pass of sum_fn over every head, in the given order."""
+    consume = collections.deque(maxlen=0).extend
+    consume(map(sum_fn, heads))   # warmup pass
+    t0 = time.perf_counter_ns()
+    for _ in range(passes):
+        consume(map(sum_fn, heads))
+    return (time.perf_counter_ns() - t0) / passes
+
+
+def bench_workingset(totals, list_length, node_budget):
+    """Many short lists traversed one after another.
+
+    For each total node count, builds total // list_length lists of
+    list_length nodes and times passes over all of them, visiting the
+    lists in build order (round robin) and in a fixed random order. The
+    working set is the total at the implementation's bytes/node.
+    """
+    print(f"Working set: lists of {list_length:,} nodes, "
+          f"~{node_budget:,} nodes traversed per cell")
+    print(f"{'implementation':14s}  {'lists':>10s}  {'nodes':>11s}  "
+          f"{'working set':>12s}  {'round robin':>11s}  {'random':>8s}")
+    print("-" * 76)
+    for label, NodeClass, sum_fn in NATIVE_IMPLS.values():
+        if NodeClass is None:
+            continue
+        bytes_per_node = list_bytes_per_node(NodeClass)
+        for total in totals:
+            lists = max(1, total // list_length)
+            nodes = lists * list_length
+            heads = [build_list(NodeClass, list_length)
+                     for _ in range(lists)]
+            expected = list_length * (list_length - 1) // 2
+            assert sum_fn(heads[-1]) == expected, \
+                f"{label} wrong: {sum_fn(heads[-1])} != {expected}"
+            shuffled = heads[:]
+            random.Random(0).shuffle(shuffled)
+            passes = max(3, node_budget // nodes)
+            rr = time_lists(sum_fn, heads, passes) / nodes
+            rnd = time_lists(sum_fn, shuffled, passes) / nodes
+            del heads, shuffled
+            print(f"{label:14s}  {lists:10,d}  {nodes:11,d}  "
+                  f"{format_bytes(nodes * bytes_per_node):>12s}  "
+                  f"{rr:11.3f}  {rnd:8.3f}")
+
+
+def physical_cpus():
+    """CPUs this process may run on, one per physical core (the first of
+    each core's SMT siblings), so pinned workers don't share a core."""
+    cpus = []
+    seen = set()
+    for cpu in sorted(os.sched_getaffinity(0)):
+        siblings = read_sysfs(f"/sys/devices/system/cpu/cpu{cpu}/topology/"
+                              "thread_siblings_list", str(cpu))
+        if siblings not in seen:
+            seen.add(siblings)
+            cpus.append(cpu)
+    return cpus
+
+
+def contention_child(impl, n, iterations, cpu):
+    """Body of one contending worker: pin to cpu, build and warm up, say
+    "ready", then wait for "go" on stdin so all workers time together.
+    Prints mean ns/node and the anomalies seen from cpu as a JSON line."""
+    os.sched_setaffinity(0, {cpu})
+    anomalies = environment_anomalies(pinned=True)
+    _, NodeClass, sum_fn = NATIVE_IMPLS[impl]
+    head = build_list(NodeClass, n)
+    for _ in range(max(1, iterations // 10)):
+        sum_fn(head)
+    print("ready", flush=True)
+    sys.stdin.readline()
+    ns = measure(sum_fn, head, iterations, warmup=1)
+    print(json.dumps({"ns_per_node": ns / n, "anomalies": anomalies}),
+          flush=True)
+
+
+def contention_run(impl, n, iterations, cpus):
+    """Run one pinned contention_child per cpu at once; the result dict of
+    each."""
+    cmd = [sys.executable, os.path.abspath(__file__),
+           "--contention-child", impl, "--nodes", str(n),
+           "--iterations", str(iterations)]
+    procs = [subprocess.Popen(cmd + ["--cpu", str(cpu)],
+                              stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                              text=True)
+             for cpu in cpus]
+    try:
+        for p in procs:
+            if p.stdout.readline().strip() != "ready":
+                raise RuntimeError(f"contention worker for {impl} failed")
+        for p in procs:
+            p.stdin.write("go\n")
+            p.stdin.flush()
+        return [json.loads(p.stdout.readline()) for p in procs]
+    except BaseException:
+        for p in procs:
+            p.kill()
+        raise
+    finally:
+        for p in procs:
+            p.wait()
+
+
+def bench_contention(n, node_budget, counts):
+    """Per-process traversal time with N pinned processes at once.
+
+    Each worker has its own list of n nodes on its own physical core;
+    past the private caches they compete for the shared L3 and memory
+    bandwidth. Slowdown is relative to the same implementation alone,
+    so a 1-process run always comes first.
+    """
+    cpus = physical_cpus()
+    counts = counts or [c for c in (1, 2, 4, 8, 16, 32, 64, 128, 256)
+                        if c <= len(cpus)]
+    counts = [1] + [c for c in counts if c != 1]
+    iterations = max(3, node_budget // n)
+    print(f"Contention: {n:,} nodes per process, {iterations:,} traversals, "
+          f"{len(cpus)} physical cores available")
+    print(f"{'processes':>9s}  {'implementation':14s}  {'mean ns/node':>12s}  "
+          f"{'max ns/node':>11s}  {'slowdown':>8s}")
+    print("-" * 64)
+    alone = {}
+    for count in counts:
+        if count > len(cpus):
+            print(f"{count:9d}  more processes than physical cores, skipped")
+            continue
+        for impl, (label, NodeClass, _) in NATIVE_IMPLS.items():
+            if NodeClass is None:
+                continue
+            results = contention_run(impl, n, iterations, cpus[:count])
+            times = [r["ns_per_node"] for r in results]
+            mean = sum(times) / len(times)
+            if count == 1:
+                alone[impl] = mean
+            print(f"{count:9d}  {label:14s}  {mean:12.3f}  "
+                  f"{max(times):11.3f}  {mean / alone[impl]:7.2f}x")
+            print_row_anomalies(results)
+
+
+def percentile(sorted_values, q):
+    """q-th percentile (0..100) of an ascending list, nearest rank."""
+    assert sorted_values, "percentile of no samples"
+    i = min(len(sorted_values) - 1, int(q / 100 * len(sorted_values)))
+    return sorted_values[i]
+
+
+GIL_SWITCH_INTERVALS = (0.0005, 0.005, 0.05)   # 0.005 s is CPython's default
+
+
+def spinner(running, counts, slot, cpu=None):
+    """CPU-bound pure Python until running[0] is cleared, pinned to cpu
+    if given."""
+    if cpu is not None:
+        os.sched_setaffinity(0, {cpu})   # 0: this thread only
+    loops = 0
+    while running[0]:
+        loops += 1
+    counts[slot] = loops
+
+
+def gil_cell(fn, head, threads, duration, cpus=None):
+    """Call fn(head) back to back for duration seconds while threads
+    spinners compete for the GIL. With cpus, spinner i is pinned to
+    cpus[(i + 1) % len(cpus)] (the caller runs on cpus[0]). Returns
+    (sorted per-call ns, spinner loops in total)."""
+    running = [True]
+    counts = [0] * threads
+    spinners = [threading.Thread(
+                    target=spinner,
+                    args=(running, counts, i,
+                          cpus[(i + 1) % len(cpus)] if cpus else None))
+                for i in range(threads)]
+    for t in spinners:
+        t.start()
+    latencies = []
+    deadline = time.perf_counter_ns() + int(duration * 1e9)
+    try:
+        while True:
+            t0 = time.perf_counter_ns()
+            fn(head)
+            t1 = time.perf_counter_ns()
+            latencies.append(t1 - t0)
+            if t1 >= deadline:
+                break
+    finally:
+        running[0] = False
+        for t in spinners:
+            t.join()
+    return sorted(latencies), sum(counts)
+
+
+def bench_gil(n, thread_counts, intervals, duration, cpus=None):
+    """Traversal latency and throughput with competing Python threads.
+
+    The Python loop gives up the GIL at every switch interval, so its
+    calls stretch by the spinners' turns; a native loop holds it for the
+    whole call, so its calls stay short but the spinners stall behind it.
+    """
+    rows = [
+        ("python_sum_list", python_sum_list, PyNode),
+        ("c_sum_list", c_sum_list, CNode),
+        ("rust_sum_list", rust_sum_list, RustNode),
+    ]
+    gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(f"GIL contention: {n:,} nodes, {duration:g} s per cell, "
+          f"GIL {'enabled' if gil else 'disabled'}")
+    print(f"{'threads':>7s}  {'switch':>7s}  {'function':16s}  "
+          f"{'p50 us':>9s}  {'p99 us':>9s}  {'max us':>9s}  "
+          f"{'calls/s':>9s}  {'spins/s':>11s}")
+    print("-" * 90)
+    default_interval = sys.getswitchinterval()
+    affinity = os.sched_getaffinity(0)
+    if cpus:
+        os.sched_setaffinity(0, {cpus[0]})
+    try:
+        for threads in thread_counts:
+            for interval in intervals:
+                sys.setswitchinterval(interval)
+                for label, fn, NodeClass in rows:
+                    head = build_list(NodeClass, n)
+                    measure(fn, head, 100, warmup=100)
+                    lat, spins = gil_cell(fn, head, threads, duration,
+                                          cpus)
+                    print(f"{threads:7d}  {interval * 1e3:5.1f}ms  "
+                          f"{label:16s}  {percentile(lat, 50) / 1e3:9.1f}  "
+                          f"{percentile(lat, 99) / 1e3:9.1f}  "
+                          f"{lat[-1] / 1e3:9.1f}  "
+                          f"{len(lat) / duration:9,.0f}  "
+                          f"{spins / duration:11,.0f}")
+    finally:
+        sys.setswitchinterval(default_interval)
+        os.sched_setaffinity(0, affinity)
+
+
+def bench_interleaved(n, node_budget, rounds, seed=0):
+    """All traversals in short rounds, shuffled within each round.
+
+    Every cell runs once per round, in a fresh random order, so frequency
+    ramps, throttling and heap drift fall on all cells alike instead of
+    on whichever runs last. Ratios to C native are taken per round (the
+    two ran seconds apart) and then the median is reported. Drift is the
+    cell's median over the second half of the rounds against the first,
+    so rounds must be at least 2.
+    """
+    assert rounds >= 2, f"Rounds must be at least 2, got {rounds}"
+    cells = [(label, sum_fn, NodeClass)
+             for label, NodeClass, sum_fn in NATIVE_IMPLS.values()
+             if NodeClass is not None]
+    cells += [("Python loop, C nodes", python_sum_list, CNode),
+              ("Python loop, Rust nodes", python_sum_list, RustNode)]
+    heads = {label: build_list(NodeClass, n)
+             for label, _, NodeClass in cells}
+    calls = max(1, node_budget // (rounds * n))
+    for label, sum_fn, _ in cells:
+        measure(sum_fn, heads[label], calls, warmup=calls)
+
+    per_round = {label: [] for label, _, _ in cells}
+    rng = random.Random(seed)
+    order = list(cells)
+    for _ in range(rounds):
+        rng.shuffle(order)
+        for label, sum_fn, _ in order:
+            per_round[label].append(
+                measure(sum_fn, heads[label], calls, warmup=0) / n)
+
+    reference = per_round["C (GC)"]
+    half = rounds // 2
+    print(f"Interleaved: {n:,} nodes, {rounds} rounds of {calls:,} calls "
+          f"per cell, shuffled (seed {seed})")
+    print(f"{'cell':26s}  {'median':>8s}  {'mean':>8s}  {'stdev':>7s}  "
+          f"{'min':>8s}  {'vs C':>7s}  {'drift':>7s}")
+    print("-" * 84)
+    for label, _, _ in cells:
+        ns = per_round[label]
+        ratio = statistics.median(a / b for a, b in zip(ns, reference))
+        drift = (statistics.median(ns[half:]) / statistics.median(ns[:half])
+                 - 1)
+        print(f"{label:26s}  {statistics.median(ns):8.3f}  "
+              f"{statistics.fmean(ns):8.3f}  "
+              f"{statistics.stdev(ns):7.3f}  "
+              f"{min(ns):8.3f}  {ratio:6.2f}x  {drift:+6.1%}")
+    print("(ns/node per round; vs C is the median of per-round ratios to "
+          "C (GC); drift is 2nd-half / 1st-half median)")
+
+
+def isolated_child(impl, n, iterations, cpu=None):
+    """Body of one isolated cell: pin to cpu if given, build, warm up,
+    time; print the result and the anomalies seen as one JSON line.
+    Nothing else runs in the interpreter first."""
+    if cpu is not None:
+        os.sched_setaffinity(0, {cpu})
+    anomalies = environment_anomalies(pinned=cpu is not None)
+    _, NodeClass, sum_fn = NATIVE_IMPLS[impl]
+    head = build_list(NodeClass, n)
+    expected = n * (n - 1) // 2
+    assert sum_fn(head) == expected, f"{impl} wrong: {sum_fn(head)}"
+    ns, cycles = measure_cycles(sum_fn, head, iterations,
+                                max(1, iterations // 10))
+    print(json.dumps({"impl": impl, "nodes": n, "iterations": iterations,
+                      "ns": ns, "ref_cycles": cycles, "cpu": cpu,
+                      "anomalies": anomalies}))
+
+
+def isolated_command(impl, n, iterations, cpu=None):
+    cmd = [sys.executable, os.path.abspath(__file__), "--isolated-child",
+           impl, "--nodes", str(n), "--iterations", str(iterations)]
+    return cmd + ["--cpu", str(cpu)] if cpu is not None else cmd
+
+
+def bench_isolated(sizes, node_budget, repeats, cpus=None):
+    """Each (implementation, size) cell in fresh interpreters.
+
+    No cell sees another's heap, GC generations or allocator state, and
+    each is run repeats times with an identical environment, so the
+    spread between runs is the cell's own noise. With cpus (--cpus),
+    every run is pinned to the first, so all see the same core.
+    """
+    env = dict(os.environ, PYTHONHASHSEED="0")
+    cpu = cpus[0] if cpus else None
+    pinning = f", pinned to cpu{cpu}" if cpu is not None else ""
+    print(f"Isolated: one interpreter per run, {repeats} runs per cell, "
+          f"~{node_budget:,} nodes traversed per run{pinning}")
+    print(f"{'implementation':14s}  {'nodes':>11s}  {'median':>8s}  "
+          f"{'min':>8s}  {'max':>8s}  {'ref-cyc/node':>12s}")
+    print("-" * 70)
+    for impl, (label, NodeClass, _) in NATIVE_IMPLS.items():
+        if NodeClass is None:
+            continue
+        for n in sizes:
+            iterations = max(3, node_budget // n)
+            runs = []
+            for _ in range(repeats):
+                out = subprocess.run(
+                    isolated_command(impl, n, iterations, cpu),
+                    check=True, env=env, text=True,
+                    stdout=subprocess.PIPE).stdout
+                runs.append(json.loads(out.splitlines()[-1]))
+            ns = sorted(r["ns"] / n for r in runs)
+            cycles = [r["ref_cycles"] for r in runs
+                      if r["ref_cycles"] is not None]
+            ref = (f"{statistics.median(cycles) / n:12.2f}" if cycles
+                   else f"{'n/a':>12s}")
+            print(f"{label:14s}  {n:11,d}  {statistics.median(ns):8.3f}  "
+                  f"{ns[0]:8.3f}  {ns[-1]:8.3f}  {ref}")
+            print_row_anomalies(runs)
+    print("Re-run one cell: PYTHONHASHSEED=0 "
+          + " ".join(isolated_command("IMPL", "NODES", "ITERATIONS", cpu)))
+
+
+def specialized_instructions(NodeClass, n, calls=1000):
+    """Warm a private copy of python_sum_list on NodeClass nodes and
+    return its (opname, argval) pairs as quickened by the interpreter.
+
+    Each node type gets its own code object, so specializations for one
+    type don't overwrite another's as they would in the shared function.
+    """
+    fn = types.FunctionType(python_sum_list.__code__.replace(),
+                            python_sum_list.__globals__)
+    head = build_list(NodeClass, n)
+    for _ in range(calls):
+        fn(head)
+    return [(i.opname, i.argval)
+            for i in dis.get_instructions(fn, adaptive=True)]
+
+
+def specialization_nodes():
+    """(label, node type) for every node type python_sum_list walks."""
+    nodes = [("Python", PyNode), ("C (GC)", CNode)]
+    if C_NOGC:
+        nodes.append(("C (no GC)", C_NOGC[0]))
+    nodes.append(("Rust", RustNode))
+    return nodes
+
+
+def jit_available():
+    """Whether this interpreter was built with the experimental JIT."""
+    jit = getattr(sys, "_jit", None)
+    if jit is not None:
+        return jit.is_available()
+    return "--enable-experimental-jit" in (
+        sysconfig.get_config_var("CONFIG_ARGS") or "")
+
+
+def jit_child(n, iterations):
+    """Body of one JIT run: python_sum_list ns/node per node type, as a
+    JSON line. PYTHON_JIT in the environment decides the JIT state."""
+    jit = getattr(sys, "_jit", None)
+    results = {"enabled": jit.is_enabled() if jit else None}
+    for label, NodeClass in specialization_nodes():
+        head = build_list(NodeClass, n)
+        results[label] = measure(python_sum_list, head, iterations) / n
+    print(json.dumps(results))
+
+
+def bench_specialization(n, iterations):
+    """What python_sum_list's attribute loads and add specialize to per
+    node type, then its ns/node with the JIT off and on if available."""
+    nodes = specialization_nodes()
+    quickened = {label: specialized_instructions(NodeClass, n)
+                 for label, NodeClass in nodes}
+    print(f"Specialization of python_sum_list after warmup "
+          f"(Python {platform.python_version()})")
+    print(f"{'node type':10s}  {'.value':30s}  {'.next':30s}  +=")
+    print("-" * 98)
+    for label, _ in nodes:
+        ops = quickened[label]
+        value = [op for op, arg in ops
+                 if op.startswith("LOAD_ATTR") and arg == "value"]
+        nxt = [op for op, arg in ops
+               if op.startswith("LOAD_ATTR") and arg == "next"]
+        add = [op for op, arg in ops if op.startswith("BINARY_OP")]
+        print(f"{label:10s}  {', '.join(value) or '-':30s}  "
+              f"{', '.join(nxt) or '-':30s}  {', '.join(add) or '-'}")
+    print("(plain LOAD_ATTR/BINARY_OP, or *_ADAPTIVE on 3.11, after warmup "
+          "means the site failed to specialize)")
+    print()
+
+    if not jit_available():
+        print("JIT: not built into this interpreter, skipped")
+        return
+    print(f"python_sum_list with the experimental JIT: {n:,} nodes, "
+          f"{iterations:,} iterations, one interpreter per setting")
+    runs = {}
+    for setting in ("0", "1"):
+        env = dict(os.environ, PYTHON_JIT=setting, PYTHONHASHSEED="0")
+        cmd = [sys.executable, os.path.abspath(__file__), "--jit-child",
+               "--nodes", str(n), "--iterations", str(iterations)]
+        out = subprocess.run(cmd, check=True, env=env, text=True,
+                             stdout=subprocess.PIPE).stdout
+        runs[setting] = json.loads(out.splitlines()[-1])
+    print(f"{'node type':10s}  {'JIT off':>8s}  {'JIT on':>8s}  "
+          f"{'on/off':>7s}")
+    print("-" * 40)
+    for label, _ in nodes:
+        off, on = runs["0"][label], runs["1"][label]
+        print(f"{label:10s}  {off:8.3f}  {on:8.3f}  {on / off:6.2f}x")
+    if runs["1"]["enabled"] is False:
+        print("(PYTHON_JIT=1 did not enable the JIT)")
+
+
+def ignore(*args):
+    """Hook callback that does nothing: the cost measured is the hook's
+    dispatch, not the tool's bookkeeping."""
+    return None
+
+
+def monitoring_hook(events):
+    """(enable, disable) registering ignore for events with sys.monitoring
+    under a free tool id, or None before 3.12."""
+    monitoring = getattr(sys, "monitoring", None)
+    if monitoring is None:
+        return None
+    state = {}
+
+    def enable():
+        for tool in (monitoring.PROFILER_ID, monitoring.COVERAGE_ID, 3, 4):
+            try:
+                monitoring.use_tool_id(tool, "bench.py")
+                break
+            except ValueError:
+                continue
+        else:
+            raise RuntimeError("no free sys.monitoring tool id")
+        mask = 0
+        for event in events:
+            flag = getattr(monitoring.events, event)
+            monitoring.register_callback(tool, flag, ignore)
+            mask |= flag
+        monitoring.set_events(tool, mask)
+        state["tool"] = tool
+
+    def disable():
+        tool = state.pop("tool")
+        monitoring.set_events(tool, 0)
+        monitoring.free_tool_id(tool)
+
+    return enable, disable
+
+
+def profiler_hooks():
+    """(label, (enable, disable) or None) for each instrumentation mode,
+    "none" first. None means unavailable on this interpreter."""
+    profile = cProfile.Profile()
+    return [
+        ("none", (lambda: None, lambda: None)),
+        ("sys.setprofile", (lambda: sys.setprofile(ignore),
+                            lambda: sys.setprofile(None))),
+        ("sys.settrace", (lambda: sys.settrace(lambda *a: ignore),
+                          lambda: sys.settrace(None))),
+        ("monitoring call/start/return",
+         monitoring_hook(["CALL", "PY_START", "PY_RETURN"])),
+        ("monitoring line", monitoring_hook(["LINE"])),
+        ("cProfile", (profile.enable, profile.disable)),
+    ]
+
+
+def bench_profilers(n, target_seconds):
+    """Each traversal with a profiling or tracing hook installed.
+
+    Hooks fire per Python call, line or bytecode event: a native loop
+    pays once per call, python_sum_list once per node. The harness loop
+    calling fn is itself traced, so native rows include that per-call
+    cost too, as any instrumented caller would.
+    """
+    rows = [(label, sum_fn, NodeClass)
+            for label, NodeClass, sum_fn in NATIVE_IMPLS.values()
+            if NodeClass is not None]
+    rows.append(("Python loop, C nodes", python_sum_list, CNode))
+    print(f"Profiler overhead: {n:,} nodes, ~{target_seconds:g} s per cell")
+    print(f"{'traversal':22s}  {'hook':30s}  {'ns/node':>9s}  "
+          f"{'slowdown':>8s}")
+    print("-" * 76)
+    for label, sum_fn, NodeClass in rows:
+        head = build_list(NodeClass, n)
+        base = None
+        for hook, toggles in profiler_hooks():
+            if toggles is None:
+                print(f"{label:22s}  {hook:30s}  {'n/a':>9s}")
+                continue
+            enable, disable = toggles
+            enable()
+            try:
+                ns = measure_adaptive(sum_fn, head, target_seconds)[0] / n
+            finally:
+                disable()
+            base = base or ns
+            print(f"{label:22s}  {hook:30s}  {ns:9.3f}  {ns / base:7.1f}x")
+
+
 def get_compiler_version():
     """Get the C compiler version used to build CPython."""
     try:
@@ -94,8 +1973,7 @@ def get_rust_version():
         return "unknown"
 
 
-def main():
-    # --- Environment ---
+def print_environment(anomalies=()):
     print("=" * 60)
     print("Boundary Crossing Benchmark")
     print("=" * 60)
@@ -103,8 +1981,21 @@ def main():
     print(f"Platform: {platform.platform()}")
     print(f"CC:       {get_compiler_version()}")
     print(f"Rust:     {get_rust_version()}")
+    hz = cycle_counter_hz()
+    counter = (f", {C_CYCLES[1]} {hz / 1e9:.3f} GHz" if hz else "")
+    ghz = cpu_freq_ghz(current_cpu())
+    current = f", now {ghz:.2f} GHz" if ghz else ""
+    print(f"CPU freq: governor {cpu_governor()}, boost {cpu_boost()}"
+          f"{current}{counter}")
+    print(f"CPUs:     {format_cpu_list(os.sched_getaffinity(0))}")
+    for anomaly in anomalies:
+        print(f"Anomaly:  {anomaly}")
     print()
 
+
+def run_table(args):
+    """The original comparison: native, cross-language, abi3, ratios."""
+    N, M = args.nodes, args.iterations
     # --- Build lists ---
     py_list = build_list(PyNode, N)
     c_list = build_list(CNode, N)
@@ -126,10 +2017,17 @@ def main():
         f"python_sum_list(rust) wrong: {python_sum_list(rust_list)} != {expected}"
     print(f"Correctness: all implementations produce {expected} "
           f"(sum 0..{N-1})")
+    noops = [noop_for(fn) for fn in (python_sum_list, c_sum_list,
+                                     rust_sum_list, sum)]
+    print("Harness overhead per call (empty function, same convention): "
+          + ", ".join(f"{label} {call_overhead_ns(noop):.0f} ns"
+                      for label, noop in filter(None, noops)))
     print()
 
     # --- Benchmark ---
-    print(f"Linked list traversal: {N} nodes, {M:,} iterations")
+    timing = (f"~{TARGET_TIME:g} s per row" if TARGET_TIME
+              else f"{M:,} iterations")
+    print(f"Linked list traversal: {N} nodes, {timing}")
     print(f"{'Benchmark':40s}  {'ns/traversal':>14s}")
     print("-" * 56)
 
@@ -145,6 +2043,24 @@ def main():
     c_cross = bench("Python loop, C nodes", python_sum_list, c_list, M)
     rust_cross = bench("Python loop, Rust nodes", python_sum_list, rust_list, M)
 
+    # Built-in containers: the flat floor the node types are measured against
+    print("\n--- Built-in containers, same values (builtin sum / Python loop) ---")
+    floor = {}
+    for name, structure in container_baselines(N):
+        if name == "cons tuples":
+            print(f"{'sum(), ' + name:40s}  n/a (not iterable)")
+            loop = python_sum_cons
+        else:
+            assert sum(structure) == expected, f"sum({name}) wrong"
+            floor[name] = bench(f"sum(), {name}", sum, structure, M, N)
+            loop = python_sum_iter
+        assert loop(structure) == expected, f"Python loop, {name} wrong"
+        bench(f"Python loop, {name}", loop, structure, M, N)
+
+    # Stable ABI: same node types built against the Limited API
+    print("\n--- Stable ABI (abi3) vs version-specific build ---")
+    bench_abi3(N, M)
+
     # --- Summary ratios ---
     print("\n--- Ratios (relative to C native) ---")
     print(f"  Python native / C native:  {py_native / c_native:6.2f}x")
@@ -152,6 +2068,7 @@ def main():
     print(f"  Python cross / C native:   {py_cross / c_native:6.2f}x")
     print(f"  C cross / C native:        {c_cross / c_native:6.2f}x")
     print(f"  Rust cross / C native:     {rust_cross / c_native:6.2f}x")
+    print(f"  sum(list) / C native:      {floor['list'] / c_native:6.2f}x")
 
     # --- Falsification check ---
     print("\n--- Falsification ---")
@@ -166,5 +2083,235 @@ def main():
         print("Consistent with PyO3 extract/borrow overhead per node.")
 
 
+def run_ingest(args):
+    bench_ingest(args.records, args.chunk)
+
+
+def run_dtypes(args):
+    bench_dtypes(args.nodes, args.iterations)
+
+
+def run_packed(args):
+    bench_packed(args.sizes, args.nodes * args.iterations,
+                 args.delta_lo, args.delta_hi)
+
+
+def run_hugepages(args):
+    bench_hugepages(args.sizes, args.nodes * args.iterations)
+
+
+def run_allocators(args):
+    bench_allocators(args.nodes, args.iterations)
+
+
+def run_counters(args):
+    bench_counters(args.nodes, args.iterations, args.baseline)
+
+
+def run_calibrate(args):
+    bench_calibrate(args.nodes * args.iterations, args.levels)
+
+
+def run_cold(args):
+    bench_cold(args.nodes, args.iterations, args.evict)
+
+
+def run_workingset(args):
+    bench_workingset(args.sizes, args.list_length,
+                     args.nodes * args.iterations)
+
+
+def run_contention(args):
+    bench_contention(args.nodes, args.nodes * args.iterations,
+                     args.processes)
+
+
+def run_gil(args):
+    bench_gil(args.nodes, args.threads, args.switch_intervals, args.duration,
+              args.cpus)
+
+
+def run_interleaved(args):
+    bench_interleaved(args.nodes, args.nodes * args.iterations, args.rounds,
+                      args.seed)
+
+
+def run_isolated(args):
+    bench_isolated(args.sizes, args.nodes * args.iterations, args.repeats,
+                   args.cpus)
+
+
+def run_specialization(args):
+    bench_specialization(args.nodes, args.iterations)
+
+
+def run_profilers(args):
+    bench_profilers(args.nodes, args.target_time or 0.5)
+
+
+def run_cachegrind(args):
+    bench_cachegrind(args.nodes, args.D1 or ["32768,8,64", "65536,4,64"],
+                     args.LL)
+
+
+MODES = {
+    "table": run_table,
+    "ingest": run_ingest,
+    "dtypes": run_dtypes,
+    "packed": run_packed,
+    "hugepages": run_hugepages,
+    "allocators": run_allocators,
+    "counters": run_counters,
+    "cachegrind": run_cachegrind,
+    "calibrate": run_calibrate,
+    "cold": run_cold,
+    "workingset": run_workingset,
+    "contention": run_contention,
+    "gil": run_gil,
+    "interleaved": run_interleaved,
+    "isolated": run_isolated,
+    "specialization": run_specialization,
+    "profilers": run_profilers,
+}
+
+
+def int_list(text):
+    """argparse type: comma-separated integers, e.g. 1000,100000."""
+    return [int(x) for x in text.split(",") if x]
+
+
+def rounds_count(text):
+    """argparse type: --rounds, at least 2 so drift has two halves."""
+    rounds = int(text)
+    if rounds < 2:
+        raise argparse.ArgumentTypeError(f"must be at least 2, got {rounds}")
+    return rounds
+
+
+def float_list(text):
+    """argparse type: comma-separated floats, e.g. 0.0005,0.005."""
+    return [float(x) for x in text.split(",") if x]
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--mode", choices=list(MODES), default="table",
+                        help="benchmark to run (default: table)")
+    parser.add_argument("--nodes", type=int, default=N,
+                        help=f"list length (default: {N})")
+    parser.add_argument("--iterations", type=int, default=M,
+                        help=f"timed traversals per row (default: {M:,})")
+    parser.add_argument("--target-time", type=float, metavar="SECONDS",
+                        help="time each traversal row for about this long "
+                             "(timed calls plus the latency sample) after "
+                             "warming up to steady state, instead of a "
+                             "fixed --iterations")
+    parser.add_argument("--records", type=int, default=10_000_000,
+                        help="ingest: int64 records in the test file")
+    parser.add_argument("--chunk", type=int, default=1 << 20,
+                        help="ingest: read size in bytes")
+    parser.add_argument("--sizes", type=int_list,
+                        default=[1_000, 100_000, 1_000_000, 10_000_000],
+                        help="packed, hugepages: comma-separated list "
+                             "sizes to sweep; workingset: total nodes "
+                             "across all lists; isolated: list lengths")
+    parser.add_argument("--delta-lo", type=int, default=500,
+                        help="packed: smallest gap between values")
+    parser.add_argument("--delta-hi", type=int, default=1500,
+                        help="packed: largest gap between values")
+    parser.add_argument("--baseline", metavar="DIR",
+                        help="counters: directory with c_node/c_node_nogc "
+                             "built from the previous revision")
+    parser.add_argument("--D1", action="append", metavar="SIZE,ASSOC,LINE",
+                        help="cachegrind: L1d geometry, repeatable "
+                             "(default: 32768,8,64 [Xeon] and 65536,4,64 "
+                             "[Grace])")
+    parser.add_argument("--LL", metavar="SIZE,ASSOC,LINE",
+                        help="cachegrind: last-level cache geometry "
+                             "(default: valgrind's choice for the host)")
+    parser.add_argument("--levels", type=int_list,
+                        help="calibrate: cache levels to size lists for, "
+                             "e.g. 1,2 (default: all)")
+    parser.add_argument("--evict", choices=["sweep", "flush"],
+                        default="sweep",
+                        help="cold: evict with a buffer sweep larger than "
+                             "the LLC, or flush the nodes' cache lines "
+                             "(default: sweep)")
+    parser.add_argument("--list-length", type=int, default=16,
+                        help="workingset: nodes per list (default: 16)")
+    parser.add_argument("--processes", type=int_list,
+                        help="contention: process counts to run, e.g. "
+                             "8,32; 1 is always run first, as the baseline "
+                             "(default: powers of two up to the physical "
+                             "core count)")
+    parser.add_argument("--threads", type=int_list, default=[0, 1, 2, 4],
+                        help="gil: competing Python thread counts "
+                             "(default: 0,1,2,4)")
+    parser.add_argument("--switch-intervals", type=float_list,
+                        default=list(GIL_SWITCH_INTERVALS),
+                        help="gil: sys.setswitchinterval values in seconds "
+                             "(default: 0.0005,0.005,0.05)")
+    parser.add_argument("--duration", type=float, default=1.0,
+                        help="gil: seconds per cell (default: 1)")
+    parser.add_argument("--rounds", type=rounds_count, default=50,
+                        help="interleaved: rounds the --iterations are "
+                             "split into, at least 2 (default: 50)")
+    parser.add_argument("--seed", type=int, default=0,
+                        help="interleaved: seed for the round order")
+    parser.add_argument("--repeats", type=int, default=3,
+                        help="isolated: fresh interpreters per cell "
+                             "(default: 3)")
+    parser.add_argument("--cpus", type=int_list,
+                        help="pin to these CPUs, e.g. 2 or 2,3; threads "
+                             "and worker processes stay within them")
+    parser.add_argument("--strict", action="store_true",
+                        help="refuse to run if the environment header "
+                             "reports any anomaly")
+    # Internal: the process cachegrind simulates (see cachegrind_child)
+    parser.add_argument("--cachegrind-child", choices=list(NATIVE_IMPLS),
+                        help=argparse.SUPPRESS)
+    parser.add_argument("--traversals", type=int, default=0,
+                        help=argparse.SUPPRESS)
+    # Internal: one pinned worker of --mode contention
+    parser.add_argument("--contention-child", choices=list(NATIVE_IMPLS),
+                        help=argparse.SUPPRESS)
+    parser.add_argument("--cpu", type=int, help=argparse.SUPPRESS)
+    # Internal: one JIT setting of --mode specialization
+    parser.add_argument("--jit-child", action="store_true",
+                        help=argparse.SUPPRESS)
+    # Internal: one run of --mode isolated
+    parser.add_argument("--isolated-child", choices=list(NATIVE_IMPLS),
+                        help=argparse.SUPPRESS)
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    if args.cachegrind_child:
+        cachegrind_child(args.cachegrind_child, args.nodes, args.traversals)
+        return
+    if args.jit_child:
+        jit_child(args.nodes, args.iterations)
+        return
+    if args.isolated_child:
+        isolated_child(args.isolated_child, args.nodes, args.iterations,
+                       args.cpu)
+        return
+    if args.contention_child:
+        contention_child(args.contention_child, args.nodes, args.iterations,
+                         args.cpu)
+        return
+    global TARGET_TIME, ANOMALIES
+    TARGET_TIME = args.target_time
+    if args.cpus:
+        os.sched_setaffinity(0, args.cpus)
+    ANOMALIES = environment_anomalies(pinned=bool(args.cpus))
+    print_environment(ANOMALIES)
+    if ANOMALIES and args.strict:
+        sys.exit(f"refusing to run with {len(ANOMALIES)} anomalies "
+                 f"(--strict)")
+    MODES[args.mode](args)
+
+
 if __name__ == "__main__":
     main()
@@ -0,0 +1,334 @@
+/*
+ * c_alloc.c — pluggable object allocators for the benchmark harness.
+ *
+ * Installs a PYMEM_DOMAIN_OBJ allocator (PyMem_SetAllocator) that forwards
+ * to one of:
+ *
+ *   pymalloc  the interpreter's original object allocator (the default)
+ *   malloc    system malloc/free, as with PYTHONMALLOC=malloc
+ *   arena     bump allocation through 64 KiB slabs: consecutive allocations
+ *             are adjacent regardless of what was freed; individual frees
+ *             only count down, and a slab is reused once it is empty
+ *   pool      16-byte size classes with LIFO free lists, each class in its
+ *             own slabs: like pymalloc without arenas or pool release
+ *
+ * Every object type allocated through PyObject_Malloc is affected, so node
+ * extensions need no changes. The hook stays installed once used: objects
+ * allocated under one mode may be freed under another, so frees are routed
+ * by ownership. Arena and pool memory comes from one reserved region (slabs
+ * whose header records their kind); anything outside it goes to the
+ * original allocator, whose free also accepts plain malloc pointers. This
+ * relies on the default raw allocator, so run without PYTHONMALLOC.
+ *
+ * Requests over SMALL_MAX bytes use malloc in the arena and pool modes,
+ * as pymalloc does. When the region is exhausted, arena and pool fall back
+ * to malloc too; stats() counts those fallbacks.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define ALIGN 16
+#define SMALL_MAX 512
+#define NCLASSES (SMALL_MAX / ALIGN)
+#define SLAB_SIZE ((size_t)64 * 1024)
+#define SLAB_HEADER ALIGN                 /* sizeof(slab_header) */
+#define REGION_DEFAULT ((size_t)4 << 30)  /* reserved, touched on demand */
+
+enum mode { MODE_PYMALLOC, MODE_MALLOC, MODE_ARENA, MODE_POOL };
+static const char *mode_names[] = {"pymalloc", "malloc", "arena", "pool"};
+
+enum slab_kind { SLAB_ARENA = NCLASSES };  /* pool slabs store their class */
+
+typedef struct slab_header {
+    uint32_t kind;              /* size class index, or SLAB_ARENA */
+    uint32_t live;              /* arena: blocks not yet freed */
+    struct slab_header *next;   /* arena: free slab list link */
+} slab_header;
+
+_Static_assert(sizeof(slab_header) <= SLAB_HEADER, "slab header too big");
+
+static struct {
+    int installed;
+    enum mode mode;
+    PyMemAllocatorEx original;
+
+    char *region;       /* reserved mapping, SLAB_SIZE aligned */
+    size_t region_size;
+    size_t region_used; /* bytes handed out as slabs */
+    slab_header *free_slabs;  /* emptied arena slabs, ready for reuse */
+
+    char *arena_slab;   /* current arena slab and bump offset */
+    size_t arena_used;
+
+    void *free_list[NCLASSES];   /* pool: freed blocks per class */
+    char *pool_slab[NCLASSES];   /* pool: current slab per class */
+    size_t pool_used[NCLASSES];
+
+    Py_ssize_t fallbacks;        /* small requests malloc'd: region full */
+} state;
+
+static inline int
+in_region(const void *p)
+{
+    return state.region != NULL && (const char *)p >= state.region
+           && (const char *)p < state.region + state.region_size;
+}
+
+static inline slab_header *
+slab_of(const void *p)
+{
+    uintptr_t off = (uintptr_t)((const char *)p - state.region);
+    return (slab_header *)(state.region + (off & ~(SLAB_SIZE - 1)));
+}
+
+static char *
+new_slab(uint32_t kind)
+{
+    slab_header *slab = state.free_slabs;
+    if (slab != NULL) {
+        state.free_slabs = slab->next;
+    }
+    else {
+        if (state.region_used + SLAB_SIZE > state.region_size)
+            return NULL;
+        slab = (slab_header *)(state.region + state.region_used);
+        state.region_used += SLAB_SIZE;
+    }
+    slab->kind = kind;
+    slab->live = 0;
+    slab->next = NULL;
+    return (char *)slab;
+}
+
+static void
+release_arena_slab(slab_header *slab)
+{
+    slab->next = state.free_slabs;
+    state.free_slabs = slab;
+}
+
+/* --- Strategies ------------------------------------------------------- */
+
+static void *
+arena_malloc(size_t size)
+{
+    size = (size + ALIGN - 1) / ALIGN * ALIGN;
+    if (state.arena_slab == NULL || state.arena_used + size > SLAB_SIZE) {
+        slab_header *full = (slab_header *)state.arena_slab;
+        if (full != NULL && full->live == 0)
+            release_arena_slab(full);
+        state.arena_slab = new_slab(SLAB_ARENA);
+        state.arena_used = SLAB_HEADER;
+        if (state.arena_slab == NULL) {
+            state.fallbacks++;
+            return malloc(size);
+        }
+    }
+    void *p = state.arena_slab + state.arena_used;
+    state.arena_used += size;
+    ((slab_header *)state.arena_slab)->live++;
+    return p;
+}
+
+static void *
+pool_malloc(size_t size)
+{
+    size_t cls = (size + ALIGN - 1) / ALIGN - 1;
+    size_t block = (cls + 1) * ALIGN;
+
+    void *p = state.free_list[cls];
+    if (p != NULL) {
+        state.free_list[cls] = *(void **)p;
+        return p;
+    }
+    if (state.pool_slab[cls] == NULL
+        || state.pool_used[cls] + block > SLAB_SIZE) {
+        state.pool_slab[cls] = new_slab((uint32_t)cls);
+        state.pool_used[cls] = SLAB_HEADER;
+        if (state.pool_slab[cls] == NULL) {
+            state.fallbacks++;
+            return malloc(block);
+        }
+    }
+    p = state.pool_slab[cls] + state.pool_used[cls];
+    state.pool_used[cls] += block;
+    return p;
+}
+
+/* Bytes of p that may be copied on realloc: the block's size class, or
+ * for arena blocks (whose size is not recorded) up to the slab's end.
+ * Copying unrelated bytes past the old object is harmless. */
+static size_t
+region_block_size(const void *p)
+{
+    slab_header *slab = slab_of(p);
+    if (slab->kind == SLAB_ARENA)
+        return (size_t)((char *)slab + SLAB_SIZE - (const char *)p);
+    return ((size_t)slab->kind + 1) * ALIGN;
+}
+
+/* --- PyMemAllocatorEx hooks ------------------------------------------- */
+
+static void *
+hook_malloc(void *ctx, size_t size)
+{
+    if (size == 0)
+        size = 1;
+    switch (state.mode) {
+    case MODE_MALLOC:
+        return malloc(size);
+    case MODE_ARENA:
+        return size <= SMALL_MAX ? arena_malloc(size) : malloc(size);
+    case MODE_POOL:
+        return size <= SMALL_MAX ? pool_malloc(size) : malloc(size);
+    default:
+        return state.original.malloc(state.original.ctx, size);
+    }
+}
+
+static void *
+hook_calloc(void *ctx, size_t nelem, size_t elsize)
+{
+    if (elsize != 0 && nelem > SIZE_MAX / elsize)
+        return NULL;
+    if (state.mode == MODE_PYMALLOC)
+        return state.original.calloc(state.original.ctx, nelem, elsize);
+    size_t size = nelem * elsize;
+    void *p = hook_malloc(ctx, size);
+    if (p != NULL)
+        memset(p, 0, size);
+    return p;
+}
+
+static void
+hook_free(void *ctx, void *p)
+{
+    if (p == NULL)
+        return;
+    if (!in_region(p)) {
+        /* pymalloc's free hands foreign (malloc) pointers to raw free */
+        state.original.free(state.original.ctx, p);
+        return;
+    }
+    slab_header *slab = slab_of(p);
+    if (slab->kind == SLAB_ARENA) {
+        /* The current slab is still being bumped; it is released when
+         * it is replaced (arena_malloc) */
+        if (--slab->live == 0 && (char *)slab != state.arena_slab)
+            release_arena_slab(slab);
+        return;
+    }
+    *(void **)p = state.free_list[slab->kind];
+    state.free_list[slab->kind] = p;
+}
+
+static void *
+hook_realloc(void *ctx, void *p, size_t size)
+{
+    if (p == NULL)
+        return hook_malloc(ctx, size);
+    if (!in_region(p))
+        return state.original.realloc(state.original.ctx, p, size);
+
+    size_t old = region_block_size(p);
+    void *q = hook_malloc(ctx, size);
+    if (q == NULL)
+        return NULL;
+    memmove(q, p, old < size ? old : size);  /* may share a slab */
+    hook_free(ctx, p);
+    return q;
+}
+
+static int
+install(void)
+{
+    if (state.installed)
+        return 0;
+
+    /* Reserve address space only; pages are committed when first touched */
+    size_t size = REGION_DEFAULT + SLAB_SIZE;
+    char *base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    uintptr_t aligned = ((uintptr_t)base + SLAB_SIZE - 1) & ~(SLAB_SIZE - 1);
+    state.region = (char *)aligned;
+    state.region_size = REGION_DEFAULT;
+
+    PyMem_GetAllocator(PYMEM_DOMAIN_OBJ, &state.original);
+    PyMemAllocatorEx hook = {
+        .ctx = NULL,
+        .malloc = hook_malloc,
+        .calloc = hook_calloc,
+        .realloc = hook_realloc,
+        .free = hook_free,
+    };
+    PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &hook);
+    state.installed = 1;
+    return 0;
+}
+
+/* --- Module functions ------------------------------------------------- */
+
+static PyObject *
+use(PyObject *self, PyObject *arg)
+{
+    const char *name = PyUnicode_AsUTF8(arg);
+    if (name == NULL)
+        return NULL;
+
+    for (int i = 0; i < (int)Py_ARRAY_LENGTH(mode_names); i++) {
+        if (strcmp(name, mode_names[i]) == 0) {
+            if (install() < 0)
+                return NULL;
+            state.mode = (enum mode)i;
+            Py_RETURN_NONE;
+        }
+    }
+    PyErr_Format(PyExc_ValueError,
+                 "unknown allocator %R; expected one of "
+                 "'pymalloc', 'malloc', 'arena', 'pool'", arg);
+    return NULL;
+}
+
+static PyObject *
+stats(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return Py_BuildValue("{s:s,s:O,s:n,s:n,s:n}",
+                         "mode", mode_names[state.mode],
+                         "installed", state.installed ? Py_True : Py_False,
+                         "region_size", (Py_ssize_t)state.region_size,
+                         "region_used", (Py_ssize_t)state.region_used,
+                         "fallbacks", state.fallbacks);
+}
+
+static PyMethodDef module_methods[] = {
+    {"use", use, METH_O,
+     "use(name)\n\n"
+     "Route new object allocations to 'pymalloc', 'malloc', 'arena' or\n"
+     "'pool'. The hook is installed on first use and never removed."},
+    {"stats", stats, METH_NOARGS,
+     "Current mode, region usage and malloc fallbacks."},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef c_alloc_module = {
+    PyModuleDef_HEAD_INIT,
+    "c_alloc",
+    "Pluggable PYMEM_DOMAIN_OBJ allocators for the benchmark harness.",
+    -1,
+    module_methods
+};
+
+PyMODINIT_FUNC
+PyInit_c_alloc(void)
+{
+    return PyModule_Create(&c_alloc_module);
+}
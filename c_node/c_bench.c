@@ -0,0 +1,654 @@
+/*
+ * c_bench.c — native helpers for the benchmark harness.
+ *
+ * Nothing here is benchmarked itself: these functions inspect node lists
+ * built by the other extensions so bench.py can explain its timings.
+ *
+ *   c_locality_report(head)  where consecutive nodes sit in memory
+ *   c_cycle_counter()        the CPU's constant-rate cycle counter
+ *   c_evict(nbytes)          push everything out of cache by a sweep
+ *   c_flush(head)            clflush / dc civac head's chain
+ *   c_latency(fn, arg, n)    per-call latency percentiles of fn(arg)
+ *   c_noop(arg)              an empty METH_O function, to time call overhead
+ *   c_noop_fastcall(*args)   the same as METH_FASTCALL | METH_KEYWORDS
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_COUNTER "tsc"
+#elif defined(__aarch64__)
+#define CYCLE_COUNTER "cntvct"
+#endif
+
+#define LINE_DEFAULT 64
+#define PAGE_DEFAULT 4096
+#define COMMON_DELTAS 4
+#define HIST_BUCKETS 64   /* |delta| <= 1, <= 2, <= 4, ... <= 2**63 */
+
+/* --- Growable arrays -------------------------------------------------- */
+
+typedef struct {
+    uintptr_t *addrs;    /* node addresses in chain order */
+    Py_ssize_t n, cap;
+    PyObject **refs;     /* nodes reached through getattr, kept alive */
+    Py_ssize_t nrefs, refcap;
+} chain;
+
+static void
+chain_clear(chain *c)
+{
+    for (Py_ssize_t i = 0; i < c->nrefs; i++)
+        Py_DECREF(c->refs[i]);
+    PyMem_Free(c->addrs);
+    PyMem_Free(c->refs);
+}
+
+static int
+chain_push(chain *c, PyObject *node)
+{
+    if (c->n == c->cap) {
+        Py_ssize_t cap = c->cap ? c->cap * 2 : 1024;
+        uintptr_t *addrs = PyMem_Resize(c->addrs, uintptr_t, cap);
+        if (addrs == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        c->addrs = addrs;
+        c->cap = cap;
+    }
+    c->addrs[c->n++] = (uintptr_t)node;
+    return 0;
+}
+
+/* Steals a reference to obj, released by chain_clear */
+static int
+chain_keep(chain *c, PyObject *obj)
+{
+    if (c->nrefs == c->refcap) {
+        Py_ssize_t cap = c->refcap ? c->refcap * 2 : 1024;
+        PyObject **refs = PyMem_Resize(c->refs, PyObject *, cap);
+        if (refs == NULL) {
+            Py_DECREF(obj);
+            PyErr_NoMemory();
+            return -1;
+        }
+        c->refs = refs;
+        c->refcap = cap;
+    }
+    c->refs[c->nrefs++] = obj;
+    return 0;
+}
+
+/* --- Chain walking ---------------------------------------------------- */
+
+/* Offset of a "next" object member in type, or -1 if it has none. The C
+ * node types (c_node, c_node_nogc, c_node_typed, the abi3 builds) expose
+ * next this way; others (PyNode, RustNode) are walked with getattr. */
+static Py_ssize_t
+next_member_offset(PyTypeObject *type)
+{
+    for (PyTypeObject *t = type; t != NULL; t = t->tp_base) {
+        for (PyMemberDef *m = t->tp_members; m && m->name; m++) {
+            if (strcmp(m->name, "next") == 0 && m->type == Py_T_OBJECT_EX)
+                return m->offset;
+        }
+    }
+    return -1;
+}
+
+/* Record the addresses of head and its successors, at most limit nodes
+ * (limit < 0: until None). Member loads run no Python code, so those
+ * nodes stay alive through head; getattr results are kept in c->refs. */
+static int
+walk_chain(PyObject *head, Py_ssize_t limit, chain *c)
+{
+    PyObject *current = head;
+    PyTypeObject *cached_type = NULL;
+    Py_ssize_t offset = -1;
+
+    while (current != Py_None && (limit < 0 || c->n < limit)) {
+        if (chain_push(c, current) < 0)
+            return -1;
+
+        if (Py_TYPE(current) != cached_type) {
+            cached_type = Py_TYPE(current);
+            offset = next_member_offset(cached_type);
+        }
+        if (offset >= 0) {
+            current = *(PyObject **)((char *)current + offset);
+            if (current == NULL)
+                current = Py_None;
+            continue;
+        }
+        PyObject *next = PyObject_GetAttrString(current, "next");
+        if (next == NULL || chain_keep(c, next) < 0)
+            return -1;
+        current = next;
+    }
+    return 0;
+}
+
+/* --- Statistics ------------------------------------------------------- */
+
+static int
+cmp_uintptr(const void *a, const void *b)
+{
+    uintptr_t x = *(const uintptr_t *)a, y = *(const uintptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int
+cmp_intptr(const void *a, const void *b)
+{
+    intptr_t x = *(const intptr_t *)a, y = *(const intptr_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Distinct values of addrs >> shift; sorts scratch (n entries) */
+static Py_ssize_t
+distinct_blocks(const uintptr_t *addrs, uintptr_t *scratch, Py_ssize_t n,
+                int shift)
+{
+    for (Py_ssize_t i = 0; i < n; i++)
+        scratch[i] = addrs[i] >> shift;
+    qsort(scratch, (size_t)n, sizeof(uintptr_t), cmp_uintptr);
+    Py_ssize_t distinct = n > 0;
+    for (Py_ssize_t i = 1; i < n; i++)
+        distinct += scratch[i] != scratch[i - 1];
+    return distinct;
+}
+
+static int
+log2_ceil(uintptr_t x)
+{
+    int k = 0;
+    while (k < 63 && ((uintptr_t)1 << k) < x)
+        k++;
+    return k;
+}
+
+static long
+sysconf_or(int name, long fallback)
+{
+    long v = sysconf(name);
+    return v > 0 ? v : fallback;
+}
+
+/* Most frequent exact deltas as a list of (delta, count), largest first.
+ * Sorts deltas in place. */
+static PyObject *
+common_deltas(intptr_t *deltas, Py_ssize_t n)
+{
+    intptr_t best[COMMON_DELTAS];
+    Py_ssize_t counts[COMMON_DELTAS] = {0};
+
+    qsort(deltas, (size_t)n, sizeof(intptr_t), cmp_intptr);
+    for (Py_ssize_t i = 0; i < n;) {
+        Py_ssize_t j = i;
+        while (j < n && deltas[j] == deltas[i])
+            j++;
+        /* insertion into the top-k by count */
+        Py_ssize_t run = j - i;
+        for (int k = 0; k < COMMON_DELTAS; k++) {
+            if (run > counts[k]) {
+                for (int m = COMMON_DELTAS - 1; m > k; m--) {
+                    best[m] = best[m - 1];
+                    counts[m] = counts[m - 1];
+                }
+                best[k] = deltas[i];
+                counts[k] = run;
+                break;
+            }
+        }
+        i = j;
+    }
+
+    PyObject *result = PyList_New(0);
+    if (result == NULL)
+        return NULL;
+    for (int k = 0; k < COMMON_DELTAS && counts[k] > 0; k++) {
+        PyObject *item = Py_BuildValue("(nn)", (Py_ssize_t)best[k],
+                                       counts[k]);
+        if (item == NULL || PyList_Append(result, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return result;
+}
+
+static PyObject *
+report(const uintptr_t *addrs, Py_ssize_t n)
+{
+    long line = sysconf_or(_SC_LEVEL1_DCACHE_LINESIZE, LINE_DEFAULT);
+    long page = sysconf_or(_SC_PAGESIZE, PAGE_DEFAULT);
+    int line_shift = log2_ceil((uintptr_t)line);
+    int page_shift = log2_ceil((uintptr_t)page);
+
+    Py_ssize_t steps = n > 0 ? n - 1 : 0;
+    Py_ssize_t forward = 0, backward = 0, same_line = 0, same_page = 0;
+    Py_ssize_t hist[HIST_BUCKETS] = {0};
+    PyObject *result = NULL, *histogram = NULL, *common = NULL;
+
+    intptr_t *deltas = PyMem_New(intptr_t, steps > 0 ? steps : 1);
+    uintptr_t *scratch = PyMem_New(uintptr_t, n > 0 ? n : 1);
+    if (deltas == NULL || scratch == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    for (Py_ssize_t i = 0; i < steps; i++) {
+        uintptr_t a = addrs[i], b = addrs[i + 1];
+        intptr_t d = (intptr_t)(b - a);
+        uintptr_t mag = d < 0 ? (uintptr_t)0 - (uintptr_t)d : (uintptr_t)d;
+        deltas[i] = d;
+        forward += d > 0;
+        backward += d < 0;
+        same_line += (a >> line_shift) == (b >> line_shift);
+        same_page += (a >> page_shift) == (b >> page_shift);
+        hist[log2_ceil(mag)]++;
+    }
+
+    histogram = PyDict_New();
+    if (histogram == NULL)
+        goto done;
+    for (int k = 0; k < HIST_BUCKETS; k++) {
+        if (hist[k] == 0)
+            continue;
+        /* keyed by the bucket's upper bound on |delta| in bytes */
+        PyObject *key = PyLong_FromUnsignedLongLong(1ULL << k);
+        PyObject *count = PyLong_FromSsize_t(hist[k]);
+        int rc = (key && count) ? PyDict_SetItem(histogram, key, count) : -1;
+        Py_XDECREF(key);
+        Py_XDECREF(count);
+        if (rc < 0)
+            goto done;
+    }
+
+    common = common_deltas(deltas, steps);
+    if (common == NULL)
+        goto done;
+
+    double denom = steps > 0 ? (double)steps : 1.0;
+    result = Py_BuildValue(
+        "{s:n,s:n,s:n,s:d,s:d,s:n,s:n,s:n,s:n,s:O,s:O}",
+        "nodes", n,
+        "forward", forward,
+        "backward", backward,
+        "same_line", same_line / denom,
+        "same_page", same_page / denom,
+        "distinct_lines", distinct_blocks(addrs, scratch, n, line_shift),
+        "distinct_pages", distinct_blocks(addrs, scratch, n, page_shift),
+        "line_size", (Py_ssize_t)line,
+        "page_size", (Py_ssize_t)page,
+        "histogram", histogram,
+        "common_deltas", common);
+
+done:
+    Py_XDECREF(histogram);
+    Py_XDECREF(common);
+    PyMem_Free(deltas);
+    PyMem_Free(scratch);
+    return result;
+}
+
+/* --- Eviction -------------------------------------------------------- */
+
+/* The sweep buffer is kept between calls so only the first touches new
+ * pages; it is never freed. */
+static char *evict_buf;
+static size_t evict_size;
+
+/* Bytes an object of type has in front of its PyObject header, as
+ * CPython's _PyType_PreHeaderSize: 3.12+ reserves the two slots for a
+ * managed dict or a managed weakref list alike (3.11 has only the dict
+ * flag), and free-threaded builds keep GC state in the header itself. */
+static size_t
+preheader_size(PyTypeObject *type)
+{
+    size_t pre = 0;
+#ifndef Py_GIL_DISABLED
+    if (PyType_IS_GC(type))
+        pre += 2 * sizeof(void *);          /* PyGC_Head */
+#endif
+#if defined(Py_TPFLAGS_MANAGED_WEAKREF)
+    if (PyType_HasFeature(type, Py_TPFLAGS_MANAGED_DICT
+                                | Py_TPFLAGS_MANAGED_WEAKREF))
+        pre += 2 * sizeof(void *);          /* dict/values, weakref slots */
+#elif defined(Py_TPFLAGS_MANAGED_DICT)
+    if (PyType_HasFeature(type, Py_TPFLAGS_MANAGED_DICT))
+        pre += 2 * sizeof(void *);          /* dict/values slots */
+#endif
+    return pre;
+}
+
+static inline void
+flush_line(const void *p)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_clflush(p);
+#elif defined(__aarch64__)
+    __asm__ __volatile__("dc civac, %0" : : "r"(p) : "memory");
+#else
+    (void)p;
+#endif
+}
+
+static inline void
+flush_fence(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_mfence();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("dsb ish" : : : "memory");
+#endif
+}
+
+/* --- Latency histogram ----------------------------------------------- */
+
+/* HDR-style log-linear buckets: values below SUB are exact; above, each
+ * power of two is split into SUB linear buckets, so a bucket is within
+ * 1/SUB (~3%) of any value in it. 64-bit values need LAT_BUCKETS. */
+#define SUB_BITS 5
+#define SUB (1 << SUB_BITS)
+#define LAT_BUCKETS (SUB + (64 - SUB_BITS) * SUB)
+
+static inline Py_ssize_t
+bucket_of(uint64_t v)
+{
+    if (v < SUB)
+        return (Py_ssize_t)v;
+    int shift = 63 - __builtin_clzll(v) - SUB_BITS;
+    return SUB + (Py_ssize_t)shift * SUB + (Py_ssize_t)((v >> shift) - SUB);
+}
+
+/* Highest value recorded in bucket i (HDR's "highest equivalent"). */
+static uint64_t
+bucket_top(Py_ssize_t i)
+{
+    if (i < SUB)
+        return (uint64_t)i;
+    int shift = (int)((i - SUB) / SUB);
+    uint64_t mantissa = (uint64_t)((i - SUB) % SUB) + SUB;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+static inline uint64_t
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* --- Module functions ------------------------------------------------- */
+
+static PyObject *
+c_locality_report(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"head", "limit", NULL};
+    PyObject *head;
+    Py_ssize_t limit = -1;
+    chain c = {0};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n:c_locality_report",
+                                     kwlist, &head, &limit))
+        return NULL;
+
+    PyObject *result = NULL;
+    if (walk_chain(head, limit, &c) == 0)
+        result = report(c.addrs, c.n);
+    chain_clear(&c);
+    return result;
+}
+
+static PyObject *
+c_evict(PyObject *self, PyObject *arg)
+{
+    Py_ssize_t nbytes = PyLong_AsSsize_t(arg);
+    if (nbytes == -1 && PyErr_Occurred())
+        return NULL;
+    if (nbytes < 0) {
+        PyErr_SetString(PyExc_ValueError, "nbytes must be >= 0");
+        return NULL;
+    }
+    if ((size_t)nbytes > evict_size) {
+        char *buf = realloc(evict_buf, (size_t)nbytes);
+        if (buf == NULL)
+            return PyErr_NoMemory();
+        memset(buf + evict_size, 0, (size_t)nbytes - evict_size);
+        evict_buf = buf;
+        evict_size = (size_t)nbytes;
+    }
+
+    /* A store per line takes each line exclusive, displacing whatever
+     * was cached (including other cores' copies) */
+    long line = sysconf_or(_SC_LEVEL1_DCACHE_LINESIZE, LINE_DEFAULT);
+    volatile char *buf = evict_buf;
+    for (Py_ssize_t i = 0; i < nbytes; i += line)
+        buf[i]++;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+c_flush(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"head", "limit", NULL};
+    PyObject *head;
+    Py_ssize_t limit = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n:c_flush", kwlist,
+                                     &head, &limit))
+        return NULL;
+#if !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+    PyErr_SetString(PyExc_NotImplementedError,
+                    "c_flush: no cache flush instruction on this "
+                    "architecture; use c_evict");
+    return NULL;
+#endif
+
+    chain c = {0};
+    if (walk_chain(head, limit, &c) < 0) {
+        chain_clear(&c);
+        return NULL;
+    }
+    /* Flush lines one line apart; a line smaller than the real one only
+     * repeats flushes */
+    long line = sysconf_or(_SC_LEVEL1_DCACHE_LINESIZE, LINE_DEFAULT);
+    Py_ssize_t lines = 0;
+    for (Py_ssize_t i = 0; i < c.n; i++) {
+        PyObject *node = (PyObject *)c.addrs[i];
+        PyTypeObject *type = Py_TYPE(node);
+        uintptr_t start = c.addrs[i] - preheader_size(type);
+        uintptr_t end = c.addrs[i] + (uintptr_t)type->tp_basicsize;
+        for (uintptr_t p = start & ~(uintptr_t)(line - 1); p < end;
+             p += line, lines++)
+            flush_line((const void *)p);
+    }
+    flush_fence();
+    chain_clear(&c);
+    return PyLong_FromSsize_t(lines);
+}
+
+static PyObject *
+c_latency(PyObject *self, PyObject *args)
+{
+    PyObject *fn, *arg;
+    Py_ssize_t calls;
+    if (!PyArg_ParseTuple(args, "OOn:c_latency", &fn, &arg, &calls))
+        return NULL;
+    if (calls <= 0) {
+        PyErr_SetString(PyExc_ValueError, "calls must be positive");
+        return NULL;
+    }
+    uint64_t *hist = PyMem_Calloc(LAT_BUCKETS, sizeof(uint64_t));
+    if (hist == NULL)
+        return PyErr_NoMemory();
+
+    /* One clock read per call: each sample runs from the end of the
+     * previous call's read, so it includes one read (~20 ns), not two
+     * plus the interpreter's call overhead as timing in Python would */
+    uint64_t min = UINT64_MAX, max = 0, total = 0;
+    uint64_t prev = now_ns();
+    for (Py_ssize_t i = 0; i < calls; i++) {
+        PyObject *r = PyObject_CallOneArg(fn, arg);
+        uint64_t t = now_ns();
+        if (r == NULL) {
+            PyMem_Free(hist);
+            return NULL;
+        }
+        Py_DECREF(r);
+        uint64_t v = t - prev;
+        prev = t;
+        hist[bucket_of(v)]++;
+        total += v;
+        if (v < min)
+            min = v;
+        if (v > max)
+            max = v;
+    }
+
+    static const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+    static const char *keys[] = {"p50", "p90", "p99", "p99.9"};
+    PyObject *result = Py_BuildValue("{s:n,s:d,s:K,s:K}",
+                                     "calls", calls,
+                                     "mean", (double)total / calls,
+                                     "min", (unsigned long long)min,
+                                     "max", (unsigned long long)max);
+    uint64_t seen = 0;
+    Py_ssize_t b = 0;
+    for (int q = 0; result != NULL && q < 4; q++) {
+        uint64_t rank = (uint64_t)(quantiles[q] * calls);
+        if (rank >= (uint64_t)calls)
+            rank = calls - 1;
+        while (seen + hist[b] <= rank)
+            seen += hist[b++];
+        uint64_t top = bucket_top(b);
+        PyObject *v = PyLong_FromUnsignedLongLong(top < max ? top : max);
+        if (v == NULL || PyDict_SetItemString(result, keys[q], v) < 0)
+            Py_CLEAR(result);
+        Py_XDECREF(v);
+    }
+    PyMem_Free(hist);
+    return result;
+}
+
+/* --- Harness calibration --------------------------------------------- */
+
+/* Same calling convention as c_sum_list and friends, no work: timing it
+ * in the harness's loop gives the per-call cost to subtract. Like the sum
+ * functions it returns a new int, outside the small-int cache, so the
+ * result's allocation and release are part of that cost. */
+#define NOOP_RESULT (1L << 20)
+
+static PyObject *
+c_noop(PyObject *self, PyObject *arg)
+{
+    return PyLong_FromLong(NOOP_RESULT);
+}
+
+/* As c_noop, with builtin sum's calling convention. */
+static PyObject *
+c_noop_fastcall(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+                PyObject *kwnames)
+{
+    return PyLong_FromLong(NOOP_RESULT);
+}
+
+/* --- Cycle counter ---------------------------------------------------- */
+
+/* Reference cycles: the TSC on x86, the generic timer's virtual count on
+ * arm64. Both tick at a fixed rate regardless of frequency scaling, so
+ * bench.py calibrates the rate once against perf_counter_ns. */
+static PyObject *
+c_cycle_counter(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return PyLong_FromUnsignedLongLong(__rdtsc());
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(v));
+    return PyLong_FromUnsignedLongLong(v);
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
+static PyMethodDef module_methods[] = {
+    {"c_locality_report", (PyCFunction)(void (*)(void))c_locality_report,
+     METH_VARARGS | METH_KEYWORDS,
+     "c_locality_report(head, limit=-1)\n\n"
+     "Walk head's chain (at most limit nodes) and describe where\n"
+     "consecutive nodes sit: dict with nodes, forward/backward jumps,\n"
+     "same_line and same_page (fractions of transitions), distinct_lines,\n"
+     "distinct_pages, line_size, page_size, histogram ({upper bound on\n"
+     "|next - node| in bytes: transitions}) and common_deltas (most\n"
+     "frequent exact address deltas as (delta, count))."},
+    {"c_evict", c_evict, METH_O,
+     "c_evict(nbytes)\n\n"
+     "Store to every cache line of an nbytes buffer (kept between calls).\n"
+     "With nbytes well above the last-level cache, nothing touched before\n"
+     "the call stays cached: data, page-table entries or code."},
+    {"c_flush", (PyCFunction)(void (*)(void))c_flush,
+     METH_VARARGS | METH_KEYWORDS,
+     "c_flush(head, limit=-1)\n\n"
+     "Flush the cache lines of each node object in head's chain (at most\n"
+     "limit nodes) from every cache level: clflush on x86, dc civac on\n"
+     "arm64. Objects the nodes own (a PyNode's value int, attribute\n"
+     "storage) are not flushed. Returns the number of lines flushed."},
+    {"c_latency", c_latency, METH_VARARGS,
+     "c_latency(fn, arg, calls)\n\n"
+     "Call fn(arg) calls times, timing each call natively into a\n"
+     "log-linear histogram (~3% resolution). Returns a dict of ns: calls,\n"
+     "mean, min, max and the p50, p90, p99 and p99.9 percentiles (each\n"
+     "the top of its bucket, capped at max)."},
+    {"c_noop", c_noop, METH_O,
+     "c_noop(arg)\n\n"
+     "Return a new int. An empty METH_O function for harness calibration."},
+    {"c_noop_fastcall", (PyCFunction)(void (*)(void))c_noop_fastcall,
+     METH_FASTCALL | METH_KEYWORDS,
+     "c_noop_fastcall(*args, **kwargs)\n\n"
+     "As c_noop, with builtin sum's METH_FASTCALL | METH_KEYWORDS."},
+    {"c_cycle_counter", c_cycle_counter, METH_NOARGS,
+     "Current reference cycle count (see CYCLE_COUNTER), or None on\n"
+     "architectures without one."},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef c_bench_module = {
+    PyModuleDef_HEAD_INIT,
+    "c_bench",
+    "Native helpers for the benchmark harness.",
+    -1,
+    module_methods
+};
+
+PyMODINIT_FUNC
+PyInit_c_bench(void)
+{
+    PyObject *m = PyModule_Create(&c_bench_module);
+    if (m == NULL)
+        return NULL;
+#ifdef CYCLE_COUNTER
+    if (PyModule_AddStringConstant(m, "CYCLE_COUNTER", CYCLE_COUNTER) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+#else
+    Py_INCREF(Py_None);
+    if (PyModule_AddObject(m, "CYCLE_COUNTER", Py_None) < 0) {
+        Py_DECREF(Py_None);
+        Py_DECREF(m);
+        return NULL;
+    }
+#endif
+    return m;
+}
@@ -4,12 +4,22 @@
  * NodeObject is a genuine CPython type: PyObject_HEAD + fields.
  * c_sum_list traverses via direct struct pointer dereference —
  * the same mechanism CPython's own built-in types use.
+ *
+ * Building with -DC_NODE_STATS (C_NODE_STATS=1 for setup.py) compiles in
+ * per-thread traversal counters read by c_stats(); without it the
+ * STATS_* hooks expand to nothing and c_sum_list is unchanged.
+ *
+ * USDT probes (sys/sdt.h, when available) mark entry and exit of
+ * c_sum_list and CNode(); see the USDT section below.
  */
 
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <structmember.h>
 #include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
 
 typedef struct {
     PyObject_HEAD
@@ -17,10 +27,45 @@ typedef struct {
     PyObject *next;  /* NodeObject* or Py_None */
 } NodeObject;
 
+static PyTypeObject NodeType;
+
+/* --- USDT probes ------------------------------------------------------ */
+
+/* Static tracepoints for bpftrace/perf/SystemTap, compiled in whenever
+ * <sys/sdt.h> is available (define C_NODE_NO_USDT to leave them out):
+ *
+ *   c_node:sum_entry(head)               c_sum_list called
+ *   c_node:sum_exit(head, total, status) status -1 for a rejected head
+ *   c_node:init_entry(self)              CNode.__init__ called
+ *   c_node:init_exit(self, status)       0, or -1 with an exception set
+ *
+ * Every return path fires the exit probe. A detached probe is a single
+ * nop: no semaphore, and the arguments are values the function already
+ * has, so the loop is the same as without probes. Time a call from the
+ * tracer's timestamps at entry and exit. */
+#if defined(__has_include) && !defined(C_NODE_NO_USDT)
+#if __has_include(<sys/sdt.h>)
+#define C_NODE_USDT 1
+#endif
+#endif
+
+#ifdef C_NODE_USDT
+#include <sys/sdt.h>
+#define USDT1(probe, a)         STAP_PROBE1(c_node, probe, (a))
+#define USDT2(probe, a, b)      STAP_PROBE2(c_node, probe, (a), (b))
+#define USDT3(probe, a, b, c)   STAP_PROBE3(c_node, probe, (a), (b), (c))
+#else
+#define USDT1(probe, a)         ((void)0)
+#define USDT2(probe, a, b)      ((void)0)
+#define USDT3(probe, a, b, c)   ((void)0)
+#endif
+
+#include "node_stats.h"
+
 /* --- NodeObject type -------------------------------------------------- */
 
 static int
-Node_init(NodeObject *self, PyObject *args, PyObject *kwds)
+node_init(NodeObject *self, PyObject *args, PyObject *kwds)
 {
     Py_ssize_t nargs = PyTuple_GET_SIZE(args);
     Py_ssize_t nkw = (kwds != NULL) ? PyDict_GET_SIZE(kwds) : 0;
@@ -87,6 +132,17 @@ Node_init(NodeObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
+/* node_init between the init probes, so each of its returns fires
+ * init_exit */
+static int
+Node_init(NodeObject *self, PyObject *args, PyObject *kwds)
+{
+    USDT1(init_entry, self);
+    int status = node_init(self, args, kwds);
+    USDT2(init_exit, self, status);
+    return status;
+}
+
 static int
 Node_traverse(NodeObject *self, visitproc visit, void *arg)
 {
@@ -105,7 +161,21 @@ static void
 Node_dealloc(NodeObject *self)
 {
     PyObject_GC_UnTrack(self);
-    Node_clear(self);
+
+    /* Free uniquely-owned successors iteratively. Letting each Py_DECREF
+     * of next recurse into Node_dealloc overflows the C stack on chains
+     * of a few hundred thousand nodes (e.g. from c_load_stream). */
+    PyObject *next = self->next;
+    self->next = NULL;
+    while (next != NULL && Py_IS_TYPE(next, &NodeType)
+           && Py_REFCNT(next) == 1) {
+        NodeObject *node = (NodeObject *)next;
+        next = node->next;
+        node->next = NULL;
+        Py_DECREF(node);  /* deallocates with next == NULL: no recursion */
+    }
+    Py_XDECREF(next);
+
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -137,9 +207,13 @@ c_sum_list(PyObject *self, PyObject *head)
 {
     long total = 0;
     PyObject *current = head;
+    STATS_DECLARE(visited);
+    USDT1(sum_entry, head);
 
     /* Validate head at entry — public API boundary */
     if (current != Py_None && !PyObject_TypeCheck(current, &NodeType)) {
+        STATS_TYPE_FAILURE();
+        USDT3(sum_exit, head, total, -1);
         PyErr_SetString(PyExc_TypeError,
                         "c_sum_list expects a CNode linked list");
         return NULL;
@@ -147,18 +221,60 @@ c_sum_list(PyObject *self, PyObject *head)
 
     while (current != Py_None) {
         assert(Py_IS_TYPE(current, &NodeType));
+        STATS_VISIT(visited);
         total += ((NodeObject *)current)->value;
         current = ((NodeObject *)current)->next;
     }
+    STATS_TRAVERSAL(visited);
+    USDT3(sum_exit, head, total, 0);
 
     return PyLong_FromLong(total);
 }
 
+/* --- c_stats: read the traversal counters ----------------------------- */
+
+static PyObject *
+c_stats(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return stats_dict();
+}
+
+/* --- c_load_stream: chunked binary ingest ---------------------------- */
+
+#include "load_stream.h"
+
+_Static_assert(offsetof(NodeObject, value) == offsetof(stream_node, value)
+               && offsetof(NodeObject, next) == offsetof(stream_node, next),
+               "NodeObject must have stream_node's layout");
+
+static PyObject *
+c_load_stream(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"source", "chunk", NULL};
+    PyObject *source;
+    Py_ssize_t chunk = LOAD_STREAM_DEFAULT_CHUNK;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n:c_load_stream",
+                                     kwlist, &source, &chunk))
+        return NULL;
+    return load_stream("c_load_stream", &NodeType, source, chunk);
+}
+
 /* --- Module definition ------------------------------------------------ */
 
 static PyMethodDef module_methods[] = {
     {"c_sum_list", c_sum_list, METH_O,
      "Sum all values in a CNode linked list (direct struct access)."},
+    {"c_load_stream", (PyCFunction)(void (*)(void))c_load_stream,
+     METH_VARARGS | METH_KEYWORDS,
+     "c_load_stream(source, chunk=1048576)\n\n"
+     "Build a CNode list from little-endian int64 records, reading chunk\n"
+     "bytes at a time from a file descriptor (read(2)) or an object with\n"
+     "readinto(). Nodes are in file order; returns None for empty input."},
+    {"c_stats", c_stats, METH_NOARGS,
+     "Traversal counters summed over all threads: traversals, nodes,\n"
+     "type_failures, threads and lengths ({upper bound on chain length:\n"
+     "traversals}). None unless built with C_NODE_STATS."},
     {NULL, NULL, 0, NULL}
 };
 
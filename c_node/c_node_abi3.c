@@ -0,0 +1,221 @@
+/*
+ * c_node_abi3.c — CNode built against the Limited API (stable ABI, abi3).
+ *
+ * Same struct, same constructor semantics and same traversal loop as
+ * c_node.c, but restricted to what the stable ABI allows:
+ *   - the type is a heap type created with PyType_FromSpec (no static
+ *     PyTypeObject, whose layout is not part of the stable ABI)
+ *   - PyTuple_GET_ITEM / PyTuple_GET_SIZE / PyDict_GET_SIZE are replaced
+ *     by the function calls PyTuple_GetItem / PyTuple_Size / PyDict_Size
+ *   - Py_INCREF / Py_DECREF are out-of-line calls on 3.12+ Limited API
+ *   - tp_free is fetched with PyType_GetSlot instead of a struct read
+ *
+ * The c_sum_list_abi3 loop body is intentionally identical to c_sum_list
+ * so the benchmark measures what the Limited API does to the same source.
+ */
+
+#ifndef Py_LIMITED_API
+#define Py_LIMITED_API 0x030C0000  /* 3.12: first with Py_T_* member types */
+#endif
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <assert.h>
+#include <stddef.h>
+
+typedef struct {
+    PyObject_HEAD
+    long value;
+    PyObject *next;  /* NodeAbi3Object* or Py_None */
+} NodeAbi3Object;
+
+static PyObject *NodeAbi3Type = NULL;  /* heap type, created at import */
+
+/* --- NodeAbi3Object type ---------------------------------------------- */
+
+static int
+NodeAbi3_init(NodeAbi3Object *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t nargs = PyTuple_Size(args);
+    Py_ssize_t nkw = (kwds != NULL) ? PyDict_Size(kwds) : 0;
+
+    PyObject *value_obj = NULL;
+    PyObject *next = Py_None;
+
+    if (nargs + nkw < 1 || nargs + nkw > 2) {
+        PyErr_SetString(PyExc_TypeError,
+                        "CNodeAbi3() requires 1 or 2 arguments (value, next)");
+        return -1;
+    }
+
+    if (nargs >= 1) {
+        value_obj = PyTuple_GetItem(args, 0);
+    }
+    if (nargs >= 2) {
+        next = PyTuple_GetItem(args, 1);
+    }
+
+    /* Handle keyword arguments */
+    if (kwds != NULL) {
+        static PyObject *str_value = NULL, *str_next = NULL;
+        if (!str_value) {
+            str_value = PyUnicode_InternFromString("value");
+            str_next = PyUnicode_InternFromString("next");
+        }
+
+        PyObject *kw_val = PyDict_GetItem(kwds, str_value);
+        if (kw_val != NULL) {
+            if (value_obj != NULL) {
+                PyErr_SetString(PyExc_TypeError,
+                                "CNodeAbi3() got multiple values for 'value'");
+                return -1;
+            }
+            value_obj = kw_val;
+        }
+
+        PyObject *kw_next = PyDict_GetItem(kwds, str_next);
+        if (kw_next != NULL) {
+            if (nargs >= 2) {
+                PyErr_SetString(PyExc_TypeError,
+                                "CNodeAbi3() got multiple values for 'next'");
+                return -1;
+            }
+            next = kw_next;
+        }
+    }
+
+    if (value_obj == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+                        "CNodeAbi3() missing required argument: 'value'");
+        return -1;
+    }
+
+    long value = PyLong_AsLong(value_obj);
+    if (value == -1 && PyErr_Occurred())
+        return -1;
+
+    self->value = value;
+    Py_INCREF(next);
+    Py_XDECREF(self->next);
+    self->next = next;
+    return 0;
+}
+
+static int
+NodeAbi3_traverse(NodeAbi3Object *self, visitproc visit, void *arg)
+{
+    /* Heap type instances own a reference to their type */
+    Py_VISIT(Py_TYPE((PyObject *)self));
+    Py_VISIT(self->next);
+    return 0;
+}
+
+static int
+NodeAbi3_clear(NodeAbi3Object *self)
+{
+    Py_CLEAR(self->next);
+    return 0;
+}
+
+static void
+NodeAbi3_dealloc(NodeAbi3Object *self)
+{
+    PyTypeObject *tp = Py_TYPE((PyObject *)self);
+    freefunc tp_free = (freefunc)PyType_GetSlot(tp, Py_tp_free);
+
+    PyObject_GC_UnTrack(self);
+    NodeAbi3_clear(self);
+    tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMemberDef NodeAbi3_members[] = {
+    {"value", Py_T_LONG, offsetof(NodeAbi3Object, value), 0, "node value"},
+    {"next", Py_T_OBJECT_EX, offsetof(NodeAbi3Object, next), 0, "next node"},
+    {NULL}
+};
+
+static PyType_Slot NodeAbi3_slots[] = {
+    {Py_tp_doc, "C extension linked list node (Limited API build)"},
+    {Py_tp_new, PyType_GenericNew},
+    {Py_tp_init, NodeAbi3_init},
+    {Py_tp_dealloc, NodeAbi3_dealloc},
+    {Py_tp_traverse, NodeAbi3_traverse},
+    {Py_tp_clear, NodeAbi3_clear},
+    {Py_tp_members, NodeAbi3_members},
+    {0, NULL}
+};
+
+static PyType_Spec NodeAbi3_spec = {
+    .name = "c_node_abi3.CNodeAbi3",
+    .basicsize = sizeof(NodeAbi3Object),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .slots = NodeAbi3_slots,
+};
+
+/* --- c_sum_list_abi3: direct struct access ---------------------------- */
+
+static PyObject *
+c_sum_list_abi3(PyObject *self, PyObject *head)
+{
+    long total = 0;
+    PyObject *current = head;
+
+    /* Validate head at entry — public API boundary */
+    if (current != Py_None
+        && !PyObject_TypeCheck(current, (PyTypeObject *)NodeAbi3Type)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "c_sum_list_abi3 expects a CNodeAbi3 linked list");
+        return NULL;
+    }
+
+    while (current != Py_None) {
+        assert(Py_IS_TYPE(current, (PyTypeObject *)NodeAbi3Type));
+        total += ((NodeAbi3Object *)current)->value;
+        current = ((NodeAbi3Object *)current)->next;
+    }
+
+    return PyLong_FromLong(total);
+}
+
+/* --- Module definition ------------------------------------------------ */
+
+static PyMethodDef module_methods[] = {
+    {"c_sum_list_abi3", c_sum_list_abi3, METH_O,
+     "Sum all values in a CNodeAbi3 linked list (direct struct access)."},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef c_node_abi3_module = {
+    PyModuleDef_HEAD_INIT,
+    "c_node_abi3",
+    "CNode built against the Limited API (stable ABI).",
+    -1,
+    module_methods
+};
+
+PyMODINIT_FUNC
+PyInit_c_node_abi3(void)
+{
+    PyObject *m;
+
+    if (NodeAbi3Type == NULL) {
+        NodeAbi3Type = PyType_FromSpec(&NodeAbi3_spec);
+        if (NodeAbi3Type == NULL)
+            return NULL;
+    }
+
+    m = PyModule_Create(&c_node_abi3_module);
+    if (m == NULL)
+        return NULL;
+
+    Py_INCREF(NodeAbi3Type);
+    if (PyModule_AddObject(m, "CNodeAbi3", NodeAbi3Type) < 0) {
+        Py_DECREF(NodeAbi3Type);
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    return m;
+}
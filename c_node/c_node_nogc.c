@@ -7,12 +7,21 @@
  *
  * Used to isolate whether the C vs Rust performance difference is
  * due to cache effects (object size) rather than code quality.
+ *
+ * -DC_NODE_STATS compiles in traversal counters read by c_stats_nogc(),
+ * as in c_node.c.
+ *
+ * USDT probes under provider c_node_nogc, as in c_node.c.
  */
 
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <structmember.h>
 #include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 typedef struct {
     PyObject_HEAD
@@ -20,8 +29,75 @@ typedef struct {
     PyObject *next;
 } NodeNoGCObject;
 
+static PyTypeObject NodeNoGCType;
+
+/* USDT probes, as c_node.c: c_node_nogc:sum_entry/sum_exit around
+ * c_sum_list_nogc and init_entry/init_exit around CNodeNoGC.__init__ */
+#if defined(__has_include) && !defined(C_NODE_NO_USDT)
+#if __has_include(<sys/sdt.h>)
+#define C_NODE_USDT 1
+#endif
+#endif
+
+#ifdef C_NODE_USDT
+#include <sys/sdt.h>
+#define USDT1(probe, a)         STAP_PROBE1(c_node_nogc, probe, (a))
+#define USDT2(probe, a, b)      STAP_PROBE2(c_node_nogc, probe, (a), (b))
+#define USDT3(probe, a, b, c)   STAP_PROBE3(c_node_nogc, probe, (a), (b), (c))
+#else
+#define USDT1(probe, a)         ((void)0)
+#define USDT2(probe, a, b)      ((void)0)
+#define USDT3(probe, a, b, c)   ((void)0)
+#endif
+
+#include "node_stats.h"
+
+/* Node arena: while open, new nodes are bump-allocated from one mapping,
+ * preferably backed by huge pages, so a multi-million-node chain spans a
+ * few 2 MiB pages instead of thousands of 4 KiB ones. Memory is not
+ * reused; the mapping is released by c_arena_close_nogc once every node
+ * allocated from it has been freed. */
+#define ARENA_HUGE_PAGE (2 * 1024 * 1024)
+#define ARENA_ALIGN 16  /* pymalloc's alignment, so node size is unchanged */
+
+static struct {
+    char *base;         /* NULL when no arena is open */
+    size_t size;
+    size_t used;
+    Py_ssize_t live;    /* nodes allocated from the arena, not yet freed */
+    const char *backing;
+} arena;
+
+static PyObject *
+NodeNoGC_alloc(PyTypeObject *type, Py_ssize_t nitems)
+{
+    size_t size = (sizeof(NodeNoGCObject) + ARENA_ALIGN - 1)
+                  / ARENA_ALIGN * ARENA_ALIGN;
+
+    if (arena.base == NULL || type != &NodeNoGCType
+        || arena.used + size > arena.size)
+        return PyType_GenericAlloc(type, nitems);
+
+    PyObject *obj = (PyObject *)(arena.base + arena.used);
+    arena.used += size;
+    arena.live++;
+    memset(obj, 0, sizeof(NodeNoGCObject));
+    return PyObject_Init(obj, type);
+}
+
+static void
+NodeNoGC_free(void *p)
+{
+    if (arena.base != NULL && (char *)p >= arena.base
+        && (char *)p < arena.base + arena.size) {
+        arena.live--;
+        return;
+    }
+    PyObject_Free(p);
+}
+
 static int
-NodeNoGC_init(NodeNoGCObject *self, PyObject *args, PyObject *kwds)
+node_init(NodeNoGCObject *self, PyObject *args, PyObject *kwds)
 {
     Py_ssize_t nargs = PyTuple_GET_SIZE(args);
     Py_ssize_t nkw = (kwds != NULL) ? PyDict_GET_SIZE(kwds) : 0;
@@ -81,10 +157,30 @@ NodeNoGC_init(NodeNoGCObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
+static int
+NodeNoGC_init(NodeNoGCObject *self, PyObject *args, PyObject *kwds)
+{
+    USDT1(init_entry, self);
+    int status = node_init(self, args, kwds);
+    USDT2(init_exit, self, status);
+    return status;
+}
+
 static void
 NodeNoGC_dealloc(NodeNoGCObject *self)
 {
-    Py_XDECREF(self->next);
+    /* Free uniquely-owned successors iteratively; see Node_dealloc in
+     * c_node.c. The trashcan mechanism is not available without GC. */
+    PyObject *next = self->next;
+    self->next = NULL;
+    while (next != NULL && Py_IS_TYPE(next, &NodeNoGCType)
+           && Py_REFCNT(next) == 1) {
+        NodeNoGCObject *node = (NodeNoGCObject *)next;
+        next = node->next;
+        node->next = NULL;
+        Py_DECREF(node);
+    }
+    Py_XDECREF(next);
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -102,6 +198,8 @@ static PyTypeObject NodeNoGCType = {
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,  /* NO Py_TPFLAGS_HAVE_GC */
     .tp_new = PyType_GenericNew,
+    .tp_alloc = NodeNoGC_alloc,
+    .tp_free = NodeNoGC_free,
     .tp_init = (initproc)NodeNoGC_init,
     .tp_dealloc = (destructor)NodeNoGC_dealloc,
     .tp_members = NodeNoGC_members,
@@ -112,8 +210,12 @@ c_sum_list_nogc(PyObject *self, PyObject *head)
 {
     long total = 0;
     PyObject *current = head;
+    STATS_DECLARE(visited);
+    USDT1(sum_entry, head);
 
     if (current != Py_None && !PyObject_TypeCheck(current, &NodeNoGCType)) {
+        STATS_TYPE_FAILURE();
+        USDT3(sum_exit, head, total, -1);
         PyErr_SetString(PyExc_TypeError,
                         "c_sum_list_nogc expects a CNodeNoGC linked list");
         return NULL;
@@ -121,16 +223,175 @@ c_sum_list_nogc(PyObject *self, PyObject *head)
 
     while (current != Py_None) {
         assert(Py_IS_TYPE(current, &NodeNoGCType));
+        STATS_VISIT(visited);
         total += ((NodeNoGCObject *)current)->value;
         current = ((NodeNoGCObject *)current)->next;
     }
+    STATS_TRAVERSAL(visited);
+    USDT3(sum_exit, head, total, 0);
 
     return PyLong_FromLong(total);
 }
 
+static PyObject *
+c_stats_nogc(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return stats_dict();
+}
+
+/* c_load_stream_nogc: chunked binary ingest, as c_node.c_load_stream */
+
+#include "load_stream.h"
+
+_Static_assert(offsetof(NodeNoGCObject, value) == offsetof(stream_node, value)
+               && offsetof(NodeNoGCObject, next)
+                  == offsetof(stream_node, next),
+               "NodeNoGCObject must have stream_node's layout");
+
+static PyObject *
+c_load_stream_nogc(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"source", "chunk", NULL};
+    PyObject *source;
+    Py_ssize_t chunk = LOAD_STREAM_DEFAULT_CHUNK;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n:c_load_stream_nogc",
+                                     kwlist, &source, &chunk))
+        return NULL;
+    return load_stream("c_load_stream_nogc", &NodeNoGCType, source, chunk);
+}
+
+/* c_arena_*_nogc: open, inspect and release the node arena */
+
+/* madvise(MADV_HUGEPAGE) succeeds even when THP is off system-wide, so
+ * the sysfs mode decides whether the advice can take effect: "always" or
+ * "madvise", not "never" (nor a kernel without THP). */
+static int
+thp_enabled(void)
+{
+    char mode[128];
+    int enabled = 0;
+    FILE *f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+
+    if (f == NULL)
+        return 0;
+    if (fgets(mode, sizeof(mode), f) != NULL)
+        enabled = strstr(mode, "[never]") == NULL;
+    fclose(f);
+    return enabled;
+}
+
+static PyObject *
+c_arena_open_nogc(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"nbytes", "hugepages", NULL};
+    Py_ssize_t nbytes;
+    int hugepages = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|p:c_arena_open_nogc",
+                                     kwlist, &nbytes, &hugepages))
+        return NULL;
+    if (arena.base != NULL) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "c_arena_open_nogc: an arena is already open");
+        return NULL;
+    }
+    if (nbytes <= 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "c_arena_open_nogc: nbytes must be positive");
+        return NULL;
+    }
+
+    size_t size = ((size_t)nbytes + ARENA_HUGE_PAGE - 1)
+                  / ARENA_HUGE_PAGE * ARENA_HUGE_PAGE;
+    void *base = MAP_FAILED;
+    const char *backing = "4k";
+
+    /* Preference order: reserved huge pages (MAP_HUGETLB), transparent
+     * huge pages (MADV_HUGEPAGE), then ordinary pages. With hugepages
+     * false, THP is explicitly refused so the control really is 4 KiB. */
+#ifdef MAP_HUGETLB
+    if (hugepages) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED)
+            backing = "hugetlb";
+    }
+#endif
+    if (base == MAP_FAILED) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+            return PyErr_SetFromErrno(PyExc_OSError);
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+        if (hugepages) {
+            if (madvise(base, size, MADV_HUGEPAGE) == 0 && thp_enabled())
+                backing = "thp";
+        }
+        else {
+            (void)madvise(base, size, MADV_NOHUGEPAGE);
+        }
+#endif
+    }
+
+    arena.base = base;
+    arena.size = size;
+    arena.used = 0;
+    arena.live = 0;
+    arena.backing = backing;
+    return PyUnicode_FromString(backing);
+}
+
+static PyObject *
+c_arena_close_nogc(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (arena.base == NULL)
+        Py_RETURN_NONE;
+    if (arena.live != 0) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "c_arena_close_nogc: %zd nodes still allocated "
+                     "from the arena", arena.live);
+        return NULL;
+    }
+    if (munmap(arena.base, arena.size) != 0)
+        return PyErr_SetFromErrno(PyExc_OSError);
+    memset(&arena, 0, sizeof(arena));
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+c_arena_info_nogc(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (arena.base == NULL)
+        Py_RETURN_NONE;
+    return Py_BuildValue("{s:s,s:n,s:n,s:n}",
+                         "backing", arena.backing,
+                         "size", (Py_ssize_t)arena.size,
+                         "used", (Py_ssize_t)arena.used,
+                         "live", arena.live);
+}
+
 static PyMethodDef module_methods[] = {
     {"c_sum_list_nogc", c_sum_list_nogc, METH_O,
      "Sum all values in a CNodeNoGC linked list."},
+    {"c_load_stream_nogc", (PyCFunction)(void (*)(void))c_load_stream_nogc,
+     METH_VARARGS | METH_KEYWORDS,
+     "c_load_stream_nogc(source, chunk=1048576)\n\n"
+     "Build a CNodeNoGC list from little-endian int64 records; see\n"
+     "c_node.c_load_stream."},
+    {"c_stats_nogc", c_stats_nogc, METH_NOARGS,
+     "Traversal counters, as c_node.c_stats. None unless built with\n"
+     "C_NODE_STATS."},
+    {"c_arena_open_nogc", (PyCFunction)(void (*)(void))c_arena_open_nogc,
+     METH_VARARGS | METH_KEYWORDS,
+     "c_arena_open_nogc(nbytes, hugepages=True) -> backing\n\n"
+     "Allocate new CNodeNoGC objects from an nbytes arena until it is\n"
+     "full or closed. Returns 'hugetlb', 'thp' or '4k': the page backing\n"
+     "obtained, falling back in that order."},
+    {"c_arena_close_nogc", c_arena_close_nogc, METH_NOARGS,
+     "Unmap the arena; raises RuntimeError while arena nodes are alive."},
+    {"c_arena_info_nogc", c_arena_info_nogc, METH_NOARGS,
+     "Arena backing, size, bytes used and live nodes, or None."},
     {NULL, NULL, 0, NULL}
 };
 
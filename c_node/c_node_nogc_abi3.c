@@ -0,0 +1,182 @@
+/*
+ * c_node_nogc_abi3.c — CNodeNoGC built against the Limited API (abi3).
+ *
+ * Identical to c_node_nogc.c but restricted to the stable ABI, with the
+ * same substitutions as c_node_abi3.c (heap type via PyType_FromSpec,
+ * function-call tuple/dict access, PyType_GetSlot for tp_free).
+ * Without Py_TPFLAGS_HAVE_GC each object is 32 bytes, so this isolates
+ * the Limited API cost from the GC-size cache effect.
+ */
+
+#ifndef Py_LIMITED_API
+#define Py_LIMITED_API 0x030C0000  /* 3.12: first with Py_T_* member types */
+#endif
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <assert.h>
+#include <stddef.h>
+
+typedef struct {
+    PyObject_HEAD
+    long value;
+    PyObject *next;
+} NodeNoGCAbi3Object;
+
+static PyObject *NodeNoGCAbi3Type = NULL;  /* heap type, created at import */
+
+static int
+NodeNoGCAbi3_init(NodeNoGCAbi3Object *self, PyObject *args, PyObject *kwds)
+{
+    Py_ssize_t nargs = PyTuple_Size(args);
+    Py_ssize_t nkw = (kwds != NULL) ? PyDict_Size(kwds) : 0;
+
+    PyObject *value_obj = NULL;
+    PyObject *next = Py_None;
+
+    if (nargs + nkw < 1 || nargs + nkw > 2) {
+        PyErr_SetString(PyExc_TypeError,
+                        "CNodeNoGCAbi3() requires 1 or 2 arguments");
+        return -1;
+    }
+
+    if (nargs >= 1) value_obj = PyTuple_GetItem(args, 0);
+    if (nargs >= 2) next = PyTuple_GetItem(args, 1);
+
+    if (kwds != NULL) {
+        static PyObject *str_value = NULL, *str_next = NULL;
+        if (!str_value) {
+            str_value = PyUnicode_InternFromString("value");
+            str_next = PyUnicode_InternFromString("next");
+        }
+        PyObject *kw_val = PyDict_GetItem(kwds, str_value);
+        if (kw_val) {
+            if (value_obj) {
+                PyErr_SetString(PyExc_TypeError,
+                                "CNodeNoGCAbi3() got multiple values for 'value'");
+                return -1;
+            }
+            value_obj = kw_val;
+        }
+        PyObject *kw_next = PyDict_GetItem(kwds, str_next);
+        if (kw_next) {
+            if (nargs >= 2) {
+                PyErr_SetString(PyExc_TypeError,
+                                "CNodeNoGCAbi3() got multiple values for 'next'");
+                return -1;
+            }
+            next = kw_next;
+        }
+    }
+
+    if (!value_obj) {
+        PyErr_SetString(PyExc_TypeError,
+                        "CNodeNoGCAbi3() missing required argument: 'value'");
+        return -1;
+    }
+
+    long value = PyLong_AsLong(value_obj);
+    if (value == -1 && PyErr_Occurred())
+        return -1;
+
+    self->value = value;
+    Py_INCREF(next);
+    Py_XDECREF(self->next);
+    self->next = next;
+    return 0;
+}
+
+static void
+NodeNoGCAbi3_dealloc(NodeNoGCAbi3Object *self)
+{
+    PyTypeObject *tp = Py_TYPE((PyObject *)self);
+    freefunc tp_free = (freefunc)PyType_GetSlot(tp, Py_tp_free);
+
+    Py_XDECREF(self->next);
+    tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMemberDef NodeNoGCAbi3_members[] = {
+    {"value", Py_T_LONG, offsetof(NodeNoGCAbi3Object, value), 0, "node value"},
+    {"next", Py_T_OBJECT_EX, offsetof(NodeNoGCAbi3Object, next), 0, "next node"},
+    {NULL}
+};
+
+static PyType_Slot NodeNoGCAbi3_slots[] = {
+    {Py_tp_doc, "C extension node WITHOUT GC tracking (Limited API build)"},
+    {Py_tp_new, PyType_GenericNew},
+    {Py_tp_init, NodeNoGCAbi3_init},
+    {Py_tp_dealloc, NodeNoGCAbi3_dealloc},
+    {Py_tp_members, NodeNoGCAbi3_members},
+    {0, NULL}
+};
+
+static PyType_Spec NodeNoGCAbi3_spec = {
+    .name = "c_node_nogc_abi3.CNodeNoGCAbi3",
+    .basicsize = sizeof(NodeNoGCAbi3Object),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,  /* NO Py_TPFLAGS_HAVE_GC */
+    .slots = NodeNoGCAbi3_slots,
+};
+
+static PyObject *
+c_sum_list_nogc_abi3(PyObject *self, PyObject *head)
+{
+    long total = 0;
+    PyObject *current = head;
+
+    if (current != Py_None
+        && !PyObject_TypeCheck(current, (PyTypeObject *)NodeNoGCAbi3Type)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "c_sum_list_nogc_abi3 expects a CNodeNoGCAbi3 linked list");
+        return NULL;
+    }
+
+    while (current != Py_None) {
+        assert(Py_IS_TYPE(current, (PyTypeObject *)NodeNoGCAbi3Type));
+        total += ((NodeNoGCAbi3Object *)current)->value;
+        current = ((NodeNoGCAbi3Object *)current)->next;
+    }
+
+    return PyLong_FromLong(total);
+}
+
+static PyMethodDef module_methods[] = {
+    {"c_sum_list_nogc_abi3", c_sum_list_nogc_abi3, METH_O,
+     "Sum all values in a CNodeNoGCAbi3 linked list."},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef c_node_nogc_abi3_module = {
+    PyModuleDef_HEAD_INIT,
+    "c_node_nogc_abi3",
+    "C extension node without GC tracking (Limited API build).",
+    -1,
+    module_methods
+};
+
+PyMODINIT_FUNC
+PyInit_c_node_nogc_abi3(void)
+{
+    PyObject *m;
+
+    if (NodeNoGCAbi3Type == NULL) {
+        NodeNoGCAbi3Type = PyType_FromSpec(&NodeNoGCAbi3_spec);
+        if (NodeNoGCAbi3Type == NULL)
+            return NULL;
+    }
+
+    m = PyModule_Create(&c_node_nogc_abi3_module);
+    if (m == NULL)
+        return NULL;
+
+    Py_INCREF(NodeNoGCAbi3Type);
+    if (PyModule_AddObject(m, "CNodeNoGCAbi3", NodeNoGCAbi3Type) < 0) {
+        Py_DECREF(NodeNoGCAbi3Type);
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    return m;
+}
@@ -0,0 +1,188 @@
+/*
+ * load_stream.h — chunked binary ingest, shared by c_node.c and
+ * c_node_nogc.c.
+ *
+ *   load_stream(name, type, source, chunk)
+ *
+ * builds a linked list of type's nodes from little-endian int64 records
+ * read from source: a file descriptor (read(2), GIL released) or an
+ * object with readinto(). Memory stays bounded by one chunk-byte buffer.
+ * Nodes come from type->tp_alloc, so c_node_nogc's arena applies; type
+ * must have stream_node's layout. name prefixes error messages. Needs
+ * <errno.h>, <stdint.h> and <unistd.h>.
+ */
+
+#ifndef LOAD_STREAM_H
+#define LOAD_STREAM_H
+
+/* Layout shared by NodeObject and NodeNoGCObject */
+typedef struct {
+    PyObject_HEAD
+    long value;
+    PyObject *next;
+} stream_node;
+
+#define RECORD_SIZE 8                    /* little-endian int64 */
+#define LOAD_STREAM_DEFAULT_CHUNK (1 << 20)
+
+static inline int64_t
+load_le64(const unsigned char *p)
+{
+    uint64_t v = 0;
+    for (int i = RECORD_SIZE - 1; i >= 0; i--)
+        v = (v << 8) | p[i];  /* a single load on little-endian targets */
+    return (int64_t)v;
+}
+
+/* Fill buf[0:len] from a raw fd (read(2), GIL released) or a Python
+ * object's readinto(). Returns bytes read, 0 at EOF, -1 with an error. */
+static Py_ssize_t
+stream_read(const char *name, PyObject *source, int fd, PyObject *buf,
+            Py_ssize_t offset, Py_ssize_t len)
+{
+    if (fd >= 0) {
+        char *dst = PyByteArray_AS_STRING(buf) + offset;
+        for (;;) {
+            ssize_t n;
+            Py_BEGIN_ALLOW_THREADS
+            n = read(fd, dst, (size_t)len);
+            Py_END_ALLOW_THREADS
+            if (n >= 0)
+                return (Py_ssize_t)n;
+            if (errno != EINTR) {
+                PyErr_SetFromErrno(PyExc_OSError);
+                return -1;
+            }
+            if (PyErr_CheckSignals() < 0)
+                return -1;
+        }
+    }
+
+    /* A memoryview over the owned bytearray: if the reader keeps the
+     * view, it keeps the bytearray alive rather than a dangling pointer. */
+    PyObject *whole = PyMemoryView_FromObject(buf);
+    if (whole == NULL)
+        return -1;
+    PyObject *view = PySequence_GetSlice(whole, offset, offset + len);
+    Py_DECREF(whole);
+    if (view == NULL)
+        return -1;
+    PyObject *res = PyObject_CallMethod(source, "readinto", "O", view);
+    Py_DECREF(view);
+    if (res == NULL)
+        return -1;
+    if (res == Py_None) {
+        Py_DECREF(res);
+        PyErr_Format(PyExc_ValueError,
+                     "%s: readinto() returned None (non-blocking stream)",
+                     name);
+        return -1;
+    }
+    Py_ssize_t n = PyLong_AsSsize_t(res);
+    Py_DECREF(res);
+    if (n == -1 && PyErr_Occurred())
+        return -1;
+    if (n < 0 || n > len) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s: readinto() returned %zd for a "
+                     "%zd-byte buffer", name, n, len);
+        return -1;
+    }
+    return n;
+}
+
+static PyObject *
+load_stream(const char *name, PyTypeObject *type, PyObject *source,
+            Py_ssize_t chunk)
+{
+    int fd = -1;
+
+    if (chunk < RECORD_SIZE) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s: chunk must be at least %d bytes",
+                     name, RECORD_SIZE);
+        return NULL;
+    }
+    chunk -= chunk % RECORD_SIZE;
+
+    /* An int is a file descriptor; anything else must provide readinto() */
+    if (PyLong_Check(source)) {
+        long v = PyLong_AsLong(source);
+        if (v == -1 && PyErr_Occurred())
+            return NULL;
+        if (v < 0 || v > INT_MAX) {
+            PyErr_Format(PyExc_ValueError,
+                         "%s: invalid file descriptor %ld", name, v);
+            return NULL;
+        }
+        fd = (int)v;
+    }
+
+    /* The only buffer: memory stays bounded by chunk, not file size */
+    PyObject *buf = PyByteArray_FromStringAndSize(NULL, chunk);
+    if (buf == NULL)
+        return NULL;
+
+    PyObject *head = NULL;
+    stream_node *tail = NULL;
+    Py_ssize_t carry = 0;  /* bytes of a partial record left from last read */
+
+    for (;;) {
+        Py_ssize_t n = stream_read(name, source, fd, buf, carry,
+                                   chunk - carry);
+        if (n < 0)
+            goto error;
+        if (n == 0)
+            break;
+
+        const unsigned char *data =
+            (const unsigned char *)PyByteArray_AS_STRING(buf);
+        Py_ssize_t avail = carry + n;
+        Py_ssize_t nrec = avail / RECORD_SIZE;
+
+        for (Py_ssize_t i = 0; i < nrec; i++) {
+            int64_t v = load_le64(data + i * RECORD_SIZE);
+#if LONG_MAX < INT64_MAX
+            if (v < LONG_MIN || v > LONG_MAX) {
+                PyErr_Format(PyExc_OverflowError,
+                             "%s: record does not fit in a C long", name);
+                goto error;
+            }
+#endif
+            stream_node *node = (stream_node *)type->tp_alloc(type, 0);
+            if (node == NULL)
+                goto error;
+            node->value = (long)v;
+            node->next = Py_NewRef(Py_None);
+
+            if (tail == NULL) {
+                head = (PyObject *)node;
+            }
+            else {
+                Py_SETREF(tail->next, (PyObject *)node);  /* owns node */
+            }
+            tail = node;
+        }
+
+        carry = avail - nrec * RECORD_SIZE;
+        memmove(PyByteArray_AS_STRING(buf),
+                PyByteArray_AS_STRING(buf) + nrec * RECORD_SIZE, carry);
+    }
+
+    if (carry != 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s: stream ends with a partial record "
+                     "(%zd trailing bytes)", name, carry);
+        goto error;
+    }
+
+    Py_DECREF(buf);
+    return head != NULL ? head : Py_NewRef(Py_None);
+
+error:
+    Py_DECREF(buf);
+    Py_XDECREF(head);
+    return NULL;
+}
+
+#endif /* LOAD_STREAM_H */
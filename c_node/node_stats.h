@@ -0,0 +1,137 @@
+/*
+ * node_stats.h — per-thread traversal counters for the C sum functions.
+ *
+ * Included by c_node.c and c_node_nogc.c; each module gets its own
+ * counters. Compiled in with -DC_NODE_STATS
+ * (C_NODE_STATS=1 for setup.py), otherwise the hooks expand to nothing:
+ *
+ *   STATS_DECLARE(n)       declare the traversal's node count n
+ *   STATS_VISIT(n)         count one node
+ *   STATS_TRAVERSAL(n)     record a finished traversal of n nodes
+ *   STATS_TYPE_FAILURE()   record a head rejected by the type check
+ *
+ * stats_dict() returns the counters summed over all threads as a new
+ * dict (traversals, nodes, type_failures, threads, lengths), or None
+ * when they are not compiled in.
+ */
+
+#ifndef NODE_STATS_H
+#define NODE_STATS_H
+
+#ifdef C_NODE_STATS
+#define STATS_BUCKETS 34  /* empty, then lengths <= 1, 2, 4, ... 2**32 */
+
+/* One buffer per thread, so counting needs no atomics. Buffers are linked
+ * into all_stats under the GIL and never freed, so stats_dict() can still
+ * sum those of threads that have exited. */
+typedef struct node_stats {
+    unsigned long long traversals;
+    unsigned long long nodes;
+    unsigned long long type_failures;
+    unsigned long long lengths[STATS_BUCKETS];
+    struct node_stats *next_buffer;
+} node_stats;
+
+static _Thread_local node_stats *thread_stats;
+static node_stats *all_stats;
+
+static node_stats *
+stats_buffer(void)
+{
+    if (thread_stats == NULL) {
+        thread_stats = PyMem_RawCalloc(1, sizeof(node_stats));
+        if (thread_stats != NULL) {
+            thread_stats->next_buffer = all_stats;
+            all_stats = thread_stats;
+        }
+    }
+    return thread_stats;
+}
+
+static int
+stats_bucket(Py_ssize_t n)
+{
+    int k = 1;
+    if (n == 0)
+        return 0;
+    while (k < STATS_BUCKETS - 1 && ((Py_ssize_t)1 << (k - 1)) < n)
+        k++;
+    return k;
+}
+
+static void
+stats_traversal(Py_ssize_t n)
+{
+    node_stats *st = stats_buffer();
+    if (st != NULL) {
+        st->traversals++;
+        st->nodes += (unsigned long long)n;
+        st->lengths[stats_bucket(n)]++;
+    }
+}
+
+static void
+stats_type_failure(void)
+{
+    node_stats *st = stats_buffer();
+    if (st != NULL)
+        st->type_failures++;
+}
+
+#define STATS_DECLARE(n)        Py_ssize_t n = 0
+#define STATS_VISIT(n)          ((n)++)
+#define STATS_TRAVERSAL(n)      stats_traversal(n)
+#define STATS_TYPE_FAILURE()    stats_type_failure()
+#else
+#define STATS_DECLARE(n)
+#define STATS_VISIT(n)          ((void)0)
+#define STATS_TRAVERSAL(n)      ((void)0)
+#define STATS_TYPE_FAILURE()    ((void)0)
+#endif
+
+static PyObject *
+stats_dict(void)
+{
+#ifdef C_NODE_STATS
+    unsigned long long traversals = 0, nodes = 0, type_failures = 0;
+    unsigned long long lengths[STATS_BUCKETS] = {0};
+    Py_ssize_t threads = 0;
+
+    for (node_stats *st = all_stats; st != NULL; st = st->next_buffer) {
+        traversals += st->traversals;
+        nodes += st->nodes;
+        type_failures += st->type_failures;
+        for (int k = 0; k < STATS_BUCKETS; k++)
+            lengths[k] += st->lengths[k];
+        threads++;
+    }
+
+    PyObject *hist = PyDict_New();
+    if (hist == NULL)
+        return NULL;
+    for (int k = 0; k < STATS_BUCKETS; k++) {
+        if (lengths[k] == 0)
+            continue;
+        /* keyed by the bucket's upper bound on chain length */
+        PyObject *key = PyLong_FromLongLong(k == 0 ? 0 : 1LL << (k - 1));
+        PyObject *count = PyLong_FromUnsignedLongLong(lengths[k]);
+        int rc = (key && count) ? PyDict_SetItem(hist, key, count) : -1;
+        Py_XDECREF(key);
+        Py_XDECREF(count);
+        if (rc < 0) {
+            Py_DECREF(hist);
+            return NULL;
+        }
+    }
+    return Py_BuildValue("{s:K,s:K,s:K,s:n,s:N}",
+                         "traversals", traversals,
+                         "nodes", nodes,
+                         "type_failures", type_failures,
+                         "threads", threads,
+                         "lengths", hist);
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
+#endif /* NODE_STATS_H */
@@ -1,7 +1,24 @@
-"""Build configuration for c_node C extension."""
+"""Build configuration for c_node C extensions.
+
+The *_abi3 modules are the same node types compiled against the Limited
+API (stable ABI); they are built alongside the version-specific modules
+so bench.py can compare the two on the same interpreter.
+
+C_NODE_STATS=1 in the environment compiles the traversal counters into
+c_node and c_node_nogc (see c_stats / c_stats_nogc). C_NODE_NO_USDT=1
+leaves out their USDT probes, so a build can be compared instruction for
+instruction against one made where <sys/sdt.h> is missing.
+"""
+
+import os
 
 from setuptools import setup, Extension
 
+STATS_MACROS = ([("C_NODE_STATS", "1")]
+                if os.environ.get("C_NODE_STATS") else [])
+STATS_MACROS += ([("C_NODE_NO_USDT", "1")]
+                 if os.environ.get("C_NODE_NO_USDT") else [])
+
 setup(
     name="c_node",
     version="0.1.0",
@@ -9,6 +26,41 @@ setup(
         Extension(
             "c_node",
             sources=["c_node.c"],
+            depends=["node_stats.h", "load_stream.h"],
+            define_macros=STATS_MACROS,
+        ),
+        Extension(
+            "c_node_nogc",
+            sources=["c_node_nogc.c"],
+            depends=["node_stats.h", "load_stream.h"],
+            define_macros=STATS_MACROS,
+        ),
+        Extension(
+            "c_node_typed",
+            sources=["c_node_typed.c"],
+            depends=["typed_node.h"],
+        ),
+        Extension(
+            "c_node_packed",
+            sources=["c_node_packed.c"],
+        ),
+        Extension(
+            "c_alloc",
+            sources=["c_alloc.c"],
+        ),
+        Extension(
+            "c_bench",
+            sources=["c_bench.c"],
+        ),
+        Extension(
+            "c_node_abi3",
+            sources=["c_node_abi3.c"],
+            py_limited_api=True,
+        ),
+        Extension(
+            "c_node_nogc_abi3",
+            sources=["c_node_nogc_abi3.c"],
+            py_limited_api=True,
         ),
     ],
 )
@@ -0,0 +1,313 @@
+/*
+ * typed_node.h — template for a linked list node specialised by value type.
+ *
+ * Included once per dtype by c_node_typed.c. Before including, define:
+ *
+ *   TN_SUFFIX          type-name suffix, e.g. Int32 (-> CNodeInt32)
+ *   TN_LOWER           function-name suffix, e.g. int32 (-> c_sum_list_int32)
+ *   TN_CTYPE           C type of the value field
+ *   TN_ACC             C type of the traversal accumulator
+ *   TN_FROM_PY(o, p)   store Python object o into *p; 0 or -1 with an error
+ *   TN_TO_PY(v)        new reference for a value
+ *   TN_ACC_TO_PY(a)    new reference for an accumulator
+ *
+ * Each inclusion defines, without GC tracking (as c_node_nogc.c):
+ *
+ *   CNode<Suffix>      PyObject_HEAD + value + next, one object per node
+ *   CFlatList<Suffix>  header-free layout: the same list held as a values[]
+ *                      array plus a uint32 next-index array, so each node
+ *                      costs sizeof(TN_CTYPE) + 4 bytes instead of an object
+ *   c_sum_list_<lower> / c_sum_flat_<lower>  METH_O traversal kernels
+ *   register_<lower>   readies both types and adds them to the module
+ *
+ * The macros are undefined again at the end so the next dtype can be
+ * defined.
+ */
+
+#define TN_CAT_(a, b) a##b
+#define TN_CAT(a, b) TN_CAT_(a, b)
+#define TN_STR_(a) #a
+#define TN_STR(a) TN_STR_(a)
+
+#define TN_OBJ       TN_CAT(TN_CAT(Node, TN_SUFFIX), Object)
+#define TN_TYPE      TN_CAT(TN_CAT(Node, TN_SUFFIX), Type)
+#define TN_FN(name)  TN_CAT(TN_CAT(Node, TN_SUFFIX), _##name)
+#define TN_FLAT      TN_CAT(TN_CAT(FlatList, TN_SUFFIX), Object)
+#define TN_FLAT_TYPE TN_CAT(TN_CAT(FlatList, TN_SUFFIX), Type)
+#define TN_FLAT_FN(name) TN_CAT(TN_CAT(FlatList, TN_SUFFIX), _##name)
+
+#define TN_NODE_NAME "CNode" TN_STR(TN_SUFFIX)
+#define TN_FLAT_NAME "CFlatList" TN_STR(TN_SUFFIX)
+
+typedef struct {
+    PyObject_HEAD
+    TN_CTYPE value;
+    PyObject *next;  /* TN_OBJ* or Py_None */
+} TN_OBJ;
+
+static PyTypeObject TN_TYPE;
+
+/* --- CNode<Suffix> ---------------------------------------------------- */
+
+static int
+TN_FN(init)(TN_OBJ *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"value", "next", NULL};
+    PyObject *value_obj;
+    PyObject *next = Py_None;
+    TN_CTYPE value;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O:" TN_NODE_NAME,
+                                     kwlist, &value_obj, &next))
+        return -1;
+    if (next != Py_None && !Py_IS_TYPE(next, &TN_TYPE)) {
+        PyErr_SetString(PyExc_TypeError,
+                        TN_NODE_NAME "() next must be None or "
+                        TN_NODE_NAME);
+        return -1;
+    }
+    if (TN_FROM_PY(value_obj, &value) < 0)
+        return -1;
+
+    self->value = value;
+    Py_INCREF(next);
+    Py_XDECREF(self->next);
+    self->next = next;
+    return 0;
+}
+
+static void
+TN_FN(dealloc)(TN_OBJ *self)
+{
+    /* Iterative teardown of uniquely-owned successors (see c_node.c) */
+    PyObject *next = self->next;
+    self->next = NULL;
+    while (next != NULL && Py_IS_TYPE(next, &TN_TYPE)
+           && Py_REFCNT(next) == 1) {
+        TN_OBJ *node = (TN_OBJ *)next;
+        next = node->next;
+        node->next = NULL;
+        Py_DECREF(node);
+    }
+    Py_XDECREF(next);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+TN_FN(get_value)(TN_OBJ *self, void *closure)
+{
+    return TN_TO_PY(self->value);
+}
+
+static PyGetSetDef TN_FN(getset)[] = {
+    {"value", (getter)TN_FN(get_value), NULL, "node value", NULL},
+    {NULL}
+};
+
+static PyMemberDef TN_FN(members)[] = {
+    {"next", Py_T_OBJECT_EX, offsetof(TN_OBJ, next), Py_READONLY,
+     "next node"},
+    {NULL}
+};
+
+static PyTypeObject TN_TYPE = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "c_node_typed." TN_NODE_NAME,
+    .tp_doc = "Linked list node with a " TN_STR(TN_CTYPE)
+              " value, no GC tracking",
+    .tp_basicsize = sizeof(TN_OBJ),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,  /* NO Py_TPFLAGS_HAVE_GC */
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)TN_FN(init),
+    .tp_dealloc = (destructor)TN_FN(dealloc),
+    .tp_members = TN_FN(members),
+    .tp_getset = TN_FN(getset),
+};
+
+static PyObject *
+TN_CAT(c_sum_list_, TN_LOWER)(PyObject *self, PyObject *head)
+{
+    TN_ACC total = 0;
+    PyObject *current = head;
+
+    if (current != Py_None && !PyObject_TypeCheck(current, &TN_TYPE)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "c_sum_list_" TN_STR(TN_LOWER) " expects a "
+                        TN_NODE_NAME " linked list");
+        return NULL;
+    }
+
+    while (current != Py_None) {
+        assert(Py_IS_TYPE(current, &TN_TYPE));
+        total += ((TN_OBJ *)current)->value;
+        current = ((TN_OBJ *)current)->next;
+    }
+
+    return TN_ACC_TO_PY(total);
+}
+
+/* --- CFlatList<Suffix>: header-free nodes ----------------------------- */
+
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t length;
+    uint32_t head;       /* index of the first node, FLAT_END if empty */
+    TN_CTYPE *values;    /* values[i]: value of node i */
+    uint32_t *next;      /* next[i]: index of node i's successor */
+} TN_FLAT;
+
+static PyTypeObject TN_FLAT_TYPE;
+
+static PyObject *
+TN_FLAT_FN(new)(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"values", NULL};
+    PyObject *iterable;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:" TN_FLAT_NAME,
+                                     kwlist, &iterable))
+        return NULL;
+
+    PyObject *seq = PySequence_Fast(iterable,
+                                    TN_FLAT_NAME "() expects an iterable");
+    if (seq == NULL)
+        return NULL;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    if (n >= (Py_ssize_t)FLAT_END) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_OverflowError,
+                        TN_FLAT_NAME "() holds at most 2**32 - 1 nodes");
+        return NULL;
+    }
+
+    TN_FLAT *self = (TN_FLAT *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    self->length = n;
+    self->head = n > 0 ? 0 : FLAT_END;
+    self->values = PyMem_New(TN_CTYPE, n > 0 ? n : 1);
+    self->next = PyMem_New(uint32_t, n > 0 ? n : 1);
+    if (self->values == NULL || self->next == NULL) {
+        Py_DECREF(seq);
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        if (TN_FROM_PY(items[i], &self->values[i]) < 0) {
+            Py_DECREF(seq);
+            Py_DECREF(self);
+            return NULL;
+        }
+        self->next[i] = (i + 1 < n) ? (uint32_t)(i + 1) : FLAT_END;
+    }
+    Py_DECREF(seq);
+    return (PyObject *)self;
+}
+
+static void
+TN_FLAT_FN(dealloc)(TN_FLAT *self)
+{
+    PyMem_Free(self->values);
+    PyMem_Free(self->next);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static Py_ssize_t
+TN_FLAT_FN(len)(TN_FLAT *self)
+{
+    return self->length;
+}
+
+static PyObject *
+TN_FLAT_FN(get_nbytes)(TN_FLAT *self, void *closure)
+{
+    return PyLong_FromSsize_t(self->length
+                              * (Py_ssize_t)(sizeof(TN_CTYPE)
+                                             + sizeof(uint32_t)));
+}
+
+static PyGetSetDef TN_FLAT_FN(getset)[] = {
+    {"nbytes", (getter)TN_FLAT_FN(get_nbytes), NULL,
+     "bytes of node storage (values + next indices)", NULL},
+    {NULL}
+};
+
+static PySequenceMethods TN_FLAT_FN(as_sequence) = {
+    .sq_length = (lenfunc)TN_FLAT_FN(len),
+};
+
+static PyTypeObject TN_FLAT_TYPE = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "c_node_typed." TN_FLAT_NAME,
+    .tp_doc = TN_FLAT_NAME "(values)\n\n"
+              "Header-free linked list of " TN_STR(TN_CTYPE)
+              " values: parallel values[] and next-index arrays.",
+    .tp_basicsize = sizeof(TN_FLAT),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = TN_FLAT_FN(new),
+    .tp_dealloc = (destructor)TN_FLAT_FN(dealloc),
+    .tp_as_sequence = &TN_FLAT_FN(as_sequence),
+    .tp_getset = TN_FLAT_FN(getset),
+};
+
+static PyObject *
+TN_CAT(c_sum_flat_, TN_LOWER)(PyObject *self, PyObject *list)
+{
+    if (!PyObject_TypeCheck(list, &TN_FLAT_TYPE)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "c_sum_flat_" TN_STR(TN_LOWER) " expects a "
+                        TN_FLAT_NAME);
+        return NULL;
+    }
+
+    const TN_CTYPE *values = ((TN_FLAT *)list)->values;
+    const uint32_t *next = ((TN_FLAT *)list)->next;
+    TN_ACC total = 0;
+
+    /* Still a dependent chain: each index comes from the previous load */
+    for (uint32_t i = ((TN_FLAT *)list)->head; i != FLAT_END; i = next[i])
+        total += values[i];
+
+    return TN_ACC_TO_PY(total);
+}
+
+static int
+TN_CAT(register_, TN_LOWER)(PyObject *m)
+{
+    if (PyType_Ready(&TN_TYPE) < 0 || PyType_Ready(&TN_FLAT_TYPE) < 0)
+        return -1;
+
+    Py_INCREF(&TN_TYPE);
+    if (PyModule_AddObject(m, TN_NODE_NAME, (PyObject *)&TN_TYPE) < 0) {
+        Py_DECREF(&TN_TYPE);
+        return -1;
+    }
+    Py_INCREF(&TN_FLAT_TYPE);
+    if (PyModule_AddObject(m, TN_FLAT_NAME, (PyObject *)&TN_FLAT_TYPE) < 0) {
+        Py_DECREF(&TN_FLAT_TYPE);
+        return -1;
+    }
+    return 0;
+}
+
+#undef TN_OBJ
+#undef TN_TYPE
+#undef TN_FN
+#undef TN_FLAT
+#undef TN_FLAT_TYPE
+#undef TN_FLAT_FN
+#undef TN_NODE_NAME
+#undef TN_FLAT_NAME
+#undef TN_SUFFIX
+#undef TN_LOWER
+#undef TN_CTYPE
+#undef TN_ACC
+#undef TN_FROM_PY
+#undef TN_TO_PY
+#undef TN_ACC_TO_PY
@@ -1,5 +1,32 @@
 use pyo3::prelude::*;
 
+/// USDT probes (`--features usdt`), the same points as c_node's:
+///
+///   rust_node:sum_entry(head)               rust_sum_list called
+///   rust_node:sum_exit(head, total, status) status -1 for a rejected head
+///   rust_node:new(value, next)              RustNode() called
+///
+/// A detached probe is a single nop (`probe!`, no semaphore); the
+/// arguments are values the function already has, so the loop is the
+/// same as without the feature. Time a call from the
+/// tracer's timestamps at entry and exit. `new` has no exit probe: PyO3
+/// extracts the arguments before the constructor runs and allocates the
+/// object after it returns, so there is nothing in between to time.
+/// Without the feature the macro only consumes its arguments.
+#[cfg(feature = "usdt")]
+macro_rules! usdt {
+    ($probe:ident $(, $arg:expr)*) => {
+        probe::probe!(rust_node, $probe $(, $arg)*);
+    };
+}
+
+#[cfg(not(feature = "usdt"))]
+macro_rules! usdt {
+    ($probe:ident $(, $arg:expr)*) => {
+        $(let _ = &$arg;)*
+    };
+}
+
 /// Rust linked list node exposed to Python via PyO3.
 ///
 /// `frozen` eliminates the borrow tracking entirely — no AtomicUsize CAS
@@ -20,6 +47,8 @@ impl RustNode {
     #[new]
     #[pyo3(signature = (value, next=None))]
     fn new(value: i64, next: Option<Py<RustNode>>) -> Self {
+        usdt!(new, value,
+              next.as_ref().map_or(std::ptr::null_mut(), |n| n.as_ptr()));
         RustNode { value, next }
     }
 }
@@ -36,13 +65,21 @@ impl RustNode {
 fn rust_sum_list(head: &Bound<'_, PyAny>) -> PyResult<i64> {
     let py = head.py();
     let mut total: i64 = 0;
+    usdt!(sum_entry, head.as_ptr());
 
     if head.is_none() {
+        usdt!(sum_exit, head.as_ptr(), total, 0isize);
         return Ok(0);
     }
 
     // Type check once at entry — not per node
-    let first: &Bound<'_, RustNode> = head.cast()?;
+    let first: &Bound<'_, RustNode> = match head.cast() {
+        Ok(first) => first,
+        Err(err) => {
+            usdt!(sum_exit, head.as_ptr(), total, -1isize);
+            return Err(err.into());
+        }
+    };
     let mut current: Py<RustNode> = first.clone().unbind();
 
     loop {
@@ -59,12 +96,35 @@ fn rust_sum_list(head: &Bound<'_, PyAny>) -> PyResult<i64> {
         }
     }
 
+    usdt!(sum_exit, head.as_ptr(), total, 0isize);
     Ok(total)
 }
 
-#[pymodule]
-fn rust_node(m: &Bound<'_, PyModule>) -> PyResult<()> {
+/// Empty function with `rust_sum_list`'s signature, for harness calibration:
+/// timing it gives the per-call cost (argument extraction, dispatch, the
+/// result int) to subtract from traversal timings.
+#[pyfunction]
+fn rust_noop(_head: &Bound<'_, PyAny>) -> PyResult<i64> {
+    Ok(1 << 20)
+}
+
+fn init_module(m: &Bound<'_, PyModule>) -> PyResult<()> {
     m.add_class::<RustNode>()?;
     m.add_function(wrap_pyfunction!(rust_sum_list, m)?)?;
+    m.add_function(wrap_pyfunction!(rust_noop, m)?)?;
     Ok(())
 }
+
+#[cfg(not(feature = "abi3"))]
+#[pymodule]
+fn rust_node(m: &Bound<'_, PyModule>) -> PyResult<()> {
+    init_module(m)
+}
+
+/// Stable-ABI build (`--features abi3`). Same code, different module name so
+/// both builds can be loaded side by side.
+#[cfg(feature = "abi3")]
+#[pymodule]
+fn rust_node_abi3(m: &Bound<'_, PyModule>) -> PyResult<()> {
+    init_module(m)
+}